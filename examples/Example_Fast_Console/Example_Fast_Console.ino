@@ -0,0 +1,89 @@
+///
+/// @file Example_Fast_Console.ino
+/// @brief Example of scrolling text console for fast edition
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Jan 2024
+/// @version 704
+///
+/// @copyright (c) Rei Vilo, 2010-2023
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+///
+/// @see ReadMe.md for references
+/// @n
+///
+/// Release 704: First release
+///
+
+// Screen
+#include "PDLS_EXT3_Basic_Fast.h"
+
+// SDK
+// #include <Arduino.h>
+#include "hV_HAL_Peripherals.h"
+
+// Include application, user and local libraries
+// #include <SPI.h>
+
+// Configuration
+#include "hV_Configuration.h"
+
+// Set parameters
+
+// Define structures and classes
+
+// Define variables and constants
+Screen_EPD_EXT3_Fast myScreen(eScreen_EPD_EXT3_271_09_Fast, boardRaspberryPiPico_RP2040);
+hV_Console myConsole;
+
+uint32_t counter = 0;
+
+// Prototypes
+
+// Utilities
+
+// Functions
+
+// Add setup code
+///
+/// @brief Setup
+///
+void setup()
+{
+    Serial.begin(115200);
+    delay(500);
+    Serial.println();
+    Serial.println("=== " __FILE__);
+    Serial.println("=== " __DATE__ " " __TIME__);
+    Serial.println();
+
+    Serial.print("begin... ");
+    myScreen.begin();
+    Serial.println(formatString("%s %ix%i", myScreen.WhoAmI().c_str(), myScreen.screenSizeX(), myScreen.screenSizeY()));
+
+    myScreen.setOrientation(ORIENTATION_LANDSCAPE);
+    myConsole.begin(&myScreen, Font_Terminal8x12);
+    myConsole.clear();
+    myConsole.println("Console");
+    myScreen.flush();
+
+    Serial.println(formatString("%i lines", myConsole.getLines()));
+}
+
+// Add loop code
+///
+/// @brief Loop, one new line per update
+///
+void loop()
+{
+    counter++;
+    uint32_t chrono = millis();
+    myConsole.println(formatString("%i: millis=%i", counter, chrono));
+    myScreen.flush();
+
+    Serial.println(formatString("%i: %i ms, %i bytes changed", counter, millis() - chrono, myScreen.getFlushChangedBytes()));
+    delay(1000);
+}
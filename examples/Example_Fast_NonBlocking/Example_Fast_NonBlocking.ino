@@ -0,0 +1,147 @@
+///
+/// @file Example_Fast_NonBlocking.ino
+/// @brief Example of non-blocking update for fast edition
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Jan 2024
+/// @version 704
+///
+/// @copyright (c) Rei Vilo, 2010-2023
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+///
+/// @see ReadMe.md for references
+/// @n
+///
+/// Release 704: First release
+///
+
+// Screen
+#include "PDLS_EXT3_Basic_Fast.h"
+
+// SDK
+// #include <Arduino.h>
+#include "hV_HAL_Peripherals.h"
+
+// Include application, user and local libraries
+// #include <SPI.h>
+
+// Configuration
+#include "hV_Configuration.h"
+
+// Set parameters
+
+// Define structures and classes
+
+// Define variables and constants
+Screen_EPD_EXT3_Fast myScreen(eScreen_EPD_EXT3_271_09_Fast, boardRaspberryPiPico_RP2040);
+
+uint32_t counter = 0;
+uint32_t chrono = 0;
+uint32_t chronoVisible = 0;
+bool flagFree = true;
+bool flagVisible = false;
+
+// Prototypes
+
+// Utilities
+///
+/// @brief Frame-buffer uploaded, free to modify
+///
+void uploaded()
+{
+    flagFree = true;
+}
+
+///
+/// @brief Refresh completed, new image visible
+///
+void visible()
+{
+    chronoVisible = millis();
+    flagVisible = true;
+}
+
+// Functions
+///
+/// @brief Draw the counter
+///
+void drawCounter()
+{
+    myScreen.setOrientation(ORIENTATION_LANDSCAPE);
+    myScreen.selectFont(Font_Terminal12x16);
+
+    uint16_t x = myScreen.screenSizeX();
+    uint16_t y = myScreen.screenSizeY();
+
+    myScreen.setPenSolid(true);
+    myScreen.dRectangle(0, y / 2, x, y / 2, myColours.white);
+    String text = formatString("Counter= %i", counter);
+    myScreen.gText((x - myScreen.stringSizeX(text)) / 2, (y * 3) / 4 - myScreen.characterSizeY() / 2, text);
+}
+
+// Add setup code
+///
+/// @brief Setup
+///
+void setup()
+{
+    Serial.begin(115200);
+    delay(500);
+    Serial.println();
+    Serial.println("=== " __FILE__);
+    Serial.println("=== " __DATE__ " " __TIME__);
+    Serial.println();
+
+    Serial.print("begin... ");
+    myScreen.begin();
+    Serial.println(formatString("%s %ix%i", myScreen.WhoAmI().c_str(), myScreen.screenSizeX(), myScreen.screenSizeY()));
+
+    myScreen.setFlushCallbacks(uploaded, visible);
+
+    // Latest request wins, at least 1 s between two updates
+    myScreen.setFlushPolicy(FLUSH_POLICY_LATEST, 1000);
+
+    myScreen.setOrientation(ORIENTATION_LANDSCAPE);
+    myScreen.selectFont(Font_Terminal12x16);
+    myScreen.gText(0, 0, "Non-blocking");
+    myScreen.flush();
+}
+
+// Add loop code
+///
+/// @brief Loop, update the counter without waiting for the screen
+///
+void loop()
+{
+    // Draw only when the frame-buffer is free
+    if (flagFree)
+    {
+        flagFree = false;
+        counter++;
+        drawCounter();
+        chrono = millis();
+        myScreen.flush_nonBlocking();
+
+        if (counter % 16 == 0)
+        {
+            flushStatistics_s statistics = myScreen.getFlushStatistics();
+            Serial.println(formatString("requested=%i started=%i merged=%i dropped=%i last=%i ms",
+                                        statistics.requested, statistics.started, statistics.merged, statistics.dropped,
+                                        myScreen.getFlushDuration()));
+        }
+    }
+
+    // Other tasks run here
+    myScreen.flush_task();
+
+    if (flagVisible)
+    {
+        flagVisible = false;
+        Serial.println(formatString("Visible after %i ms", chronoVisible - chrono));
+    }
+
+    delay(10);
+}
@@ -0,0 +1,131 @@
+///
+/// @file Example_Fast_Transposed.ino
+/// @brief Example of transposed layer for fast edition
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Jan 2024
+/// @version 704
+///
+/// @copyright (c) Rei Vilo, 2010-2023
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+///
+/// @see ReadMe.md for references
+/// @n
+///
+/// Release 704: First release
+///
+
+// Screen
+#include "PDLS_EXT3_Basic_Fast.h"
+
+// SDK
+// #include <Arduino.h>
+#include "hV_HAL_Peripherals.h"
+
+// Include application, user and local libraries
+// #include <SPI.h>
+
+// Configuration
+#include "hV_Configuration.h"
+
+// Set parameters
+
+// Define structures and classes
+
+// Define variables and constants
+Screen_EPD_EXT3_Fast myScreen(eScreen_EPD_EXT3_271_09_Fast, boardRaspberryPiPico_RP2040);
+
+// One full screen surface, 2.71" 264x176
+uint8_t arena[Screen_EPD_EXT3_Fast::surfaceSize(264, 176)];
+
+uint32_t counter = 0;
+
+// Prototypes
+
+// Utilities
+
+// Functions
+///
+/// @brief Draw-heavy page, text and lines along the x-axis
+/// @return duration, microseconds
+///
+uint32_t drawPage()
+{
+    uint32_t chrono = micros();
+    uint16_t x = myScreen.screenSizeX();
+    uint16_t y = myScreen.screenSizeY();
+
+    myScreen.clear();
+    myScreen.selectFont(Font_Terminal8x12);
+    for (uint16_t line = 0; line + 12 <= y; line += 12)
+    {
+        myScreen.gText(0, line, formatString("%i: The quick brown fox jumps over the lazy dog", counter + line / 12));
+    }
+    for (uint16_t line = 0; line < y; line += 4)
+    {
+        myScreen.line(0, line, x - 1, y - 1 - line, myColours.black);
+    }
+    return micros() - chrono;
+}
+
+///
+/// @brief Draw the page into one layer, then update
+/// @param layout SURFACE_LAYOUT_PANEL or SURFACE_LAYOUT_ROWS
+///
+void benchmark(uint8_t layout)
+{
+    myScreen.setSurfaceArena(arena, sizeof(arena));
+    surface_s * surface = myScreen.newSurface(myScreen.screenSizeX(), myScreen.screenSizeY(), layout);
+    myScreen.setLayer(0, surface, LAYER_REPLACE);
+    myScreen.selectLayer(0);
+
+    uint32_t duration = drawPage();
+    myScreen.selectLayer();
+
+    // Layer converted into panel order at flush
+    uint32_t chrono = millis();
+    myScreen.flush();
+    Serial.println(formatString("%s: draw %i us, flush %i ms",
+                                surface->transposed ? "transposed" : "panel", duration, millis() - chrono));
+
+    myScreen.setLayer(0, 0);
+    myScreen.releaseSurface(surface);
+}
+
+// Add setup code
+///
+/// @brief Setup
+///
+void setup()
+{
+    Serial.begin(115200);
+    delay(500);
+    Serial.println();
+    Serial.println("=== " __FILE__);
+    Serial.println("=== " __DATE__ " " __TIME__);
+    Serial.println();
+
+    Serial.print("begin... ");
+    myScreen.begin();
+    Serial.println(formatString("%s %ix%i", myScreen.WhoAmI().c_str(), myScreen.screenSizeX(), myScreen.screenSizeY()));
+
+    // x-axis across the rows of the panel, consecutive points one row apart with SURFACE_LAYOUT_PANEL
+    myScreen.setOrientation(ORIENTATION_LANDSCAPE);
+    Serial.println(formatString("transpose kernel %i", TRANSPOSE_KERNEL));
+}
+
+// Add loop code
+///
+/// @brief Loop, same page drawn with both layouts
+///
+void loop()
+{
+    counter++;
+    benchmark(SURFACE_LAYOUT_PANEL);
+    delay(1000);
+    benchmark(SURFACE_LAYOUT_ROWS);
+    delay(1000);
+}
@@ -32,6 +32,7 @@
 #define PDLS_EXT3_BASIC_FAST_RELEASE 703
 
 #include "Screen_EPD_EXT3.h"
+#include "hV_Console.h"
 
 #endif // PDLS_EXT3_BASIC_FAST_RELEASE
 
@@ -27,6 +27,31 @@
 // Release 701: Added support for eScreen_EPD_EXT3_290_0F_Wide xE2290KS0Fx
 // Release 702: Added support for eScreen_EPD_EXT3_206_0E_Wide xE2206KS0Ex
 // Release 703: Added support for eScreen_EPD_EXT3_152_0J_Wide xE2152KS0Jx
+// Release 704: Added pacing policies and statistics for non-blocking update
+// Release 704: Added status, callbacks and timestamps for non-blocking update
+// Release 704: Unified blocking and non-blocking update sequences
+// Release 704: Added optional worker for FreeRTOS and std::thread
+// Release 704: Added non-blocking global update and regeneration
+// Release 704: Added flush metrics, replacing FLUSH_TIMING
+// Release 704: Added ghosting score and automatic regeneration by region
+// Release 704: Added constexpr panel descriptors, replacing COG_getUserData()
+// Release 704: Added row metadata to skip unchanged frames and rows
+// Release 704: Swapped pages by row instead of copying next to previous
+// Release 704: Added temperature governor and predicted cost of next update
+// Release 704: Added screen cache with LRU eviction
+// Release 704: Specialised pixel paths by orientation and resolved colour
+// Release 704: Added spans, whole bytes instead of single pixels
+// Release 704: Added Screen_EPD_EXT3_Fast_Static with static frame-buffer
+// Release 704: Added frame-buffer provided by the caller and single page mode
+// Release 704: Added compressed previous frame for single page mode
+// Release 704: Added banded mode with display list
+// Release 704: Added tiled mode with uniform tiles and tile pool
+// Release 704: Added frame-buffer in storage with row cache
+// Release 704: Applied inversion when sent instead of when drawn
+// Release 704: Added scroll of the frame-buffer
+// Release 704: Added offscreen surfaces with copy, save and restore
+// Release 704: Added layers with masks and blend operations, composited at flush
+// Release 704: Added transposed layers, converted at flush by 8x8 bit-matrix transpose
 //
 
 // Library header
@@ -65,23 +90,32 @@ SPISettings _settingScreen;
 /// @cond
 
 // Common settings
-// 0x00, soft-reset, temperature, active temperature, PSR0, PSR1
-uint8_t indexE5_data[] = {0x19}; // Temperature 0x19 = 25 °C
-uint8_t indexE0_data[] = {0x02}; // Activate temperature
-uint8_t index00_data[] = {0xff, 0x8f}; // PSR, constant
-uint8_t index50a_data[] = {0x27}; // Only 154 213 266 and 370 screens, constant
-uint8_t index50b_data[] = {0x07}; // Only 154 213 266 and 370 screens, constant
-uint8_t index50c_data[] = {0x07}; // All screens, constant
+// 0x00, soft-reset, temperature, active temperature, PSR0, PSR1 from panel descriptor
+const uint8_t indexE0_data[] = {0x02}; // Activate temperature
+const uint8_t index50a_data[] = {0x27}; // Only 154 213 266 and 370 screens, constant
+const uint8_t index50b_data[] = {0x07}; // Only 154 213 266 and 370 screens, constant
+const uint8_t index50c_data[] = {0x07}; // All screens, constant
 
-void Screen_EPD_EXT3_Fast::COG_initial(uint8_t updateMode)
+void Screen_EPD_EXT3_Fast::COG_reset()
 {
-    if (_flag152 == true)
+    if (_panel.flag152 == true)
     {
         // Soft reset
         b_sendCommand8(0x12);
         digitalWrite(b_pin.panelDC, LOW); // Select
-        b_waitBusy(LOW); // 150 and 152 specific
+    }
+    else
+    {
+        // New algorithm
+        uint8_t index00_reset[] = {0x0e};
+        b_sendIndexData(0x00, index00_reset, 1); // Soft-reset
+    }
+}
 
+void Screen_EPD_EXT3_Fast::COG_initial(uint8_t updateMode)
+{
+    if (_panel.flag152 == true)
+    {
         // Work settings
         b_sendCommandData8(0x1a, u_temperature);
 
@@ -98,34 +132,24 @@ void Screen_EPD_EXT3_Fast::COG_initial(uint8_t updateMode)
     else
     {
         // Work settings
-        //uint8_t indexE0_work[1]; // Activate temperature
-        //uint8_t indexE5_work[1]; // Temperature
-        //uint8_t index00_work[2]; // PSR
-
         indexE0_work[0] = indexE0_data[0];
-        indexE5_data[0] = u_temperature;
         if ((u_codeExtra & FEATURE_FAST) and (updateMode != UPDATE_GLOBAL)) // Specific settings for fast update
         {
-            indexE5_work[0] = indexE5_data[0] | 0x40; // temperature | 0x40
-            index00_work[0] = index00_data[0] | 0x10; // PSR0 | 0x10
-            index00_work[1] = index00_data[1] | 0x02; // PSR1 | 0x02
+            indexE5_work[0] = u_temperature | 0x40; // temperature | 0x40
+            index00_work[0] = _panel.psr0 | 0x10; // PSR0 | 0x10
+            index00_work[1] = _panel.psr1 | 0x02; // PSR1 | 0x02
         }
         else // Common settings
         {
-            indexE5_work[0] = indexE5_data[0]; // Temperature
-            index00_work[0] = index00_data[0]; // PSR0
-            index00_work[1] = index00_data[1]; // PSR1
+            indexE5_work[0] = u_temperature; // Temperature
+            index00_work[0] = _panel.psr0; // PSR0
+            index00_work[1] = _panel.psr1; // PSR1
         } // u_codeExtra updateMode
 
-        // New algorithm
-        uint8_t index00_reset[] = {0x0e};
-        b_sendIndexData(0x00, index00_reset, 1); // Soft-reset
-        b_waitBusy();
-
         b_sendIndexData(0xe5, indexE5_work, 1); // Input Temperature
         b_sendIndexData(0xe0, indexE0_work, 1); // Activate Temperature
 
-        if (u_codeSize == 0x29) // No PSR
+        if (_panel.noPSR) // No PSR
         {
             b_sendCommandData8(0x4d, 0x55);
             b_sendCommandData8(0xe9, 0x02);
@@ -143,8 +167,8 @@ void Screen_EPD_EXT3_Fast::COG_initial(uint8_t updateMode)
             b_sendIndexData(0x50, index50c_work, 1); // Vcom and data interval setting
         }
 
-        // Additional settings for fast update, 154 213 266 and 370 screens (_flag50)
-        if ((u_codeExtra & FEATURE_FAST) and (updateMode != UPDATE_GLOBAL) and _flag50)
+        // Additional settings for fast update, 154 213 266 and 370 screens (_panel.flag50)
+        if ((u_codeExtra & FEATURE_FAST) and (updateMode != UPDATE_GLOBAL) and _panel.flag50)
         {
             uint8_t index50a_work[1]; // Vcom
             index50a_work[0] = index50a_data[0]; // 0x27
@@ -153,343 +177,1280 @@ void Screen_EPD_EXT3_Fast::COG_initial(uint8_t updateMode)
     }
 }
 
-void Screen_EPD_EXT3_Fast::COG_getUserData()
+void Screen_EPD_EXT3_Fast::COG_sendImageDataFast()
 {
-    if (_flag152 == true)
+    if (flushMaintenance > 0)
     {
-        // Empty
-                _flag50 = false;
+        COG_sendImageDataRegion();
+        return;
+    }
+
+    if (bandRows > 0)
+    {
+        // Both frames rasterised band by band from the display list
+        uint32_t chrono = micros();
+        uint8_t indexPrevious = (_panel.flag152 == true) ? 0x24 : 0x10;
+        uint8_t indexNext = (_panel.flag152 == true) ? 0x26 : 0x13;
+        flush_sendBands(indexPrevious, 0, listDisplayed, flushInvertPrevious ? 0xff : 0x00);
+        flush_sendBands(indexNext, listStart, listUsed, u_invert ? 0xff : 0x00);
+        listRasterTime = micros() - chrono;
+        flushInvertPrevious = u_invert;
+
+        // Next frame becomes displayed frame, at the start of the display list
+        memmove(listData, listData + listStart, listUsed - listStart);
+        listUsed -= listStart;
+        listStart = 0;
+        listDisplayed = listUsed;
+        flushDirty = false;
+        return;
+    }
+
+    if (flushTiled)
+    {
+        // Uniform tiles sent as fixed value
+        if (_panel.flag152 == true)
+        {
+            flush_uploadTiles(0x24, 0x26);
+        }
+        else
+        {
+            flush_uploadTiles(0x10, 0x13);
+        }
+        return;
+    }
+
+    // Metadata of the rows drawn since last upload
+    flush_scanRows();
+    flushDirty = false;
+    flushCompressionInfo.decodeTime = 0;
+
+    // Uniform rows sent as fixed value
+    if (_panel.flag152 == true)
+    {
+        flush_sendRows(0x24, 1); // Previous frame
+        flush_sendRows(0x26, 0); // Next frame
     }
     else
     {
-        uint16_t u_codeSizeType = u_eScreen_EPD_EXT3 & 0xffff;
+        flush_sendRows(0x10, 1); // Previous frame
+        flush_sendRows(0x13, 0); // Next frame
+    }
+
+    // Count toggled pixels by region, all rows if the inversion has changed
+    uint8_t inverted = (u_invert != flushInvertPrevious) ? 0xff : 0x00;
+    flushChangedBytes = 0;
+    for (uint8_t region = 0; region < FLUSH_REGIONS; region++)
+    {
+        uint16_t first = (uint32_t)u_bufferSizeV * region / FLUSH_REGIONS;
+        uint16_t last = (uint32_t)u_bufferSizeV * (region + 1) / FLUSH_REGIONS;
+        uint32_t toggles = 0;
 
-        // Size cSize cType Driver
-        switch (u_codeSizeType)
+        for (uint16_t row = first; row < last; row++)
         {
-            case 0x150C: // 1.54” = 0xcf, 0x02
-            case 0x210E: // 2.13” = 0xcf, 0x02
-            case 0x260C: // 2.66” = 0xcf, 0x02
+            if (((flushRows[row].flags & FLUSH_ROW_CHANGED) == 0) and (inverted == 0x00))
+            {
+                continue;
+            }
 
-                index00_data[0] = 0xcf;
-                index00_data[1] = 0x02;
-                _flag50 = true;
-                break;
+            const uint8_t * next = flush_row(row, 0);
+            const uint8_t * previous = flush_row(row, 1);
+            for (uint16_t index = 0; index < u_bufferSizeH; index++)
+            {
+                uint8_t toggled = previous[index] ^ next[index] ^ inverted;
+                if (toggled)
+                {
+                    toggles += __builtin_popcount(toggled);
+                    flushChangedBytes++;
+                }
+            }
+        }
+        flushToggles[region] += toggles;
+    }
+    flushInvertPrevious = u_invert;
+
+    // Changed rows swap pages, next becomes previous, no copy
+    // After all previous rows are read, as compressed rows depend on the flags
+    for (uint16_t row = 0; row < u_bufferSizeV; row++)
+    {
+        flushRow_s & meta = flushRows[row];
+        if ((meta.flags & FLUSH_ROW_CHANGED) == 0)
+        {
+            continue;
+        }
 
-            case 0x200E: // 2.06” = 0xcf, 0x02
+        // New next row outdated, copied from previous on first write
+        // Single page, page row is also previous row
+        if (not flushSinglePage)
+        {
+            meta.flags ^= FLUSH_ROW_PAGE;
+        }
+        meta.flags &= ~(FLUSH_ROW_CHANGED | FLUSH_ROW_UNIFORM_PREVIOUS);
+        meta.flags |= FLUSH_ROW_STALE;
+        meta.hash[1] = meta.hash[0];
+        meta.value[1] = meta.value[0];
+        if (meta.flags & FLUSH_ROW_UNIFORM)
+        {
+            meta.flags |= FLUSH_ROW_UNIFORM_PREVIOUS;
+        }
+    }
 
-                index00_data[0] = 0xcf;
-                index00_data[1] = 0x02;
-                _flag50 = true;
-                break;
+    // Single page, all rows displayed, saved rows released
+    if (flushSinglePage)
+    {
+        for (uint16_t row = 0; row < u_bufferSizeV; row++)
+        {
+            flushRows[row].flags &= ~(FLUSH_ROW_SAVED | FLUSH_ROW_LOST);
+            flushRows[row].flags |= FLUSH_ROW_STALE;
+        }
+        flushStatistics.redriven += flushLost;
+        flushSavedCount = 0;
+        flushLost = 0;
 
-            case 0x2709: // 2.71” = 0xcf, 0x8d
+        // Displayed frame compressed for next upload
+        flush_compress();
+    }
 
-                index00_data[0] = 0xcf;
-                index00_data[1] = 0x8d;
-                _flag50 = false;
-                break;
+    if (flushUpdateMode == UPDATE_GLOBAL)
+    {
+        // Global update clears ghosting
+        memset(flushToggles, 0x00, sizeof(flushToggles));
+    }
+}
+
+void Screen_EPD_EXT3_Fast::flush_sendBands(uint8_t index, uint32_t start, uint32_t end, uint8_t mask)
+{
+    // Band rasterised, then sent
+    b_beginIndexData(index);
+    for (uint16_t first = 0; first < u_bufferSizeV; first += bandRows)
+    {
+        uint16_t last = min((uint16_t)(first + bandRows), u_bufferSizeV);
+        flush_rasterise(first, last, start, end);
+        b_sendData(bandBuffer, (uint32_t)(last - first) * u_bufferSizeH, mask);
+    }
+    b_endIndexData();
+}
+
+void Screen_EPD_EXT3_Fast::flush_rasterise(uint16_t first, uint16_t last, uint32_t start, uint32_t end)
+{
+    // Blank as after begin(), then drawing calls clipped to the band
+    memset(bandBuffer, 0x00, (uint32_t)(last - first) * u_bufferSizeH);
+    bandFirst = first;
+    bandLast = last;
+    flush_replay(start, end);
+    bandFirst = 0;
+    bandLast = 0;
+}
+
+void Screen_EPD_EXT3_Fast::flush_replay(uint32_t start, uint32_t end)
+{
+    // State of the application, restored after
+    uint8_t oldOrientation = _orientation;
+    bool oldPenSolid = _penSolid;
+    bool oldFontSolid = f_fontSolid;
+    uint8_t oldFontSize = f_fontSize;
+    uint8_t oldFontSpaceX = f_fontSpaceX;
+    uint8_t oldFontSpaceY = f_fontSpaceY;
+    bandReplaying = true;
+
+    uint32_t offset = start;
+    while (offset < end)
+    {
+        const uint8_t * command = listData + offset;
+        uint16_t size = command[2] | (command[3] << 8);
+        uint16_t rowFirst = command[4] | (command[5] << 8);
+        uint16_t rowLast = command[6] | (command[7] << 8);
+        offset += size;
+
+        // Commands outside the band skipped
+        if ((rowLast < bandFirst) or (rowFirst >= bandLast))
+        {
+            continue;
+        }
+
+        uint8_t state = command[1];
+        if ((state & LIST_STATE_ORIENTATION) != _orientation)
+        {
+            _setOrientation(state & LIST_STATE_ORIENTATION);
+        }
+        _penSolid = (state & LIST_STATE_PEN_SOLID);
+        f_fontSolid = (state & LIST_STATE_FONT_SOLID);
+
+        // Parameters, 16-bit
+        const uint8_t * input = command + 8;
+        uint16_t value[7];
+        if (command[0] == LIST_TEXT)
+        {
+            f_fontSize = input[0];
+            f_fontSpaceX = input[1];
+            f_fontSpaceY = input[2];
+            input += 3;
+            memcpy(value, input, 8);
+        }
+        else
+        {
+            memcpy(value, input, min((uint16_t)(size - 8), (uint16_t)sizeof(value)));
+        }
 
-            case 0x2809: // 2.87” = 0xcf, 0x8d
+        switch (command[0])
+        {
+            case LIST_CLEAR:
 
-                index00_data[0] = 0xcf;
-                index00_data[1] = 0x8d;
-                _flag50 = false;
+                for (uint16_t row = bandFirst; row < bandLast; row++)
+                {
+                    _clearRow(bandBuffer + (uint32_t)(row - bandFirst) * u_bufferSizeH, row, value[0]);
+                }
                 break;
 
-            case 0x290F: // 2.90” - No PSR
+            case LIST_POINT:
 
-                index00_data[0] = 0x00;
-                index00_data[1] = 0x00;
-                _flag50 = false;
+                hV_Screen_Buffer::point(value[0], value[1], value[2]);
                 break;
 
-            case 0x370C: // 3.70” = 0xcf, 0x0f
+            case LIST_LINE:
 
-                index00_data[0] = 0xcf;
-                index00_data[1] = 0x8f;
-                _flag50 = true;
+                hV_Screen_Buffer::line(value[0], value[1], value[2], value[3], value[4]);
                 break;
 
-            case 0x410D:// 4.17” = 0x0f, 0x0e
+            case LIST_RECTANGLE:
 
-                index00_data[0] = 0x0f;
-                index00_data[1] = 0x0e;
-                _flag50 = false;
+                hV_Screen_Buffer::rectangle(value[0], value[1], value[2], value[3], value[4]);
                 break;
 
-            case 0x430C: // 4.37” = 0x0f, 0x0e
+            case LIST_CIRCLE:
 
-                index00_data[0] = 0x0f;
-                index00_data[1] = 0x0e;
-                _flag50 = true;
+                hV_Screen_Buffer::circle(value[0], value[1], value[2], value[3]);
                 break;
 
-            case 0x580B: // 5.81"
+            case LIST_TRIANGLE:
 
-                _flag50 = false;
+                hV_Screen_Buffer::triangle(value[0], value[1], value[2], value[3], value[4], value[5], value[6]);
                 break;
 
+            case LIST_TEXT:
+            {
+                char text[256];
+                uint8_t length = input[8];
+                memcpy(text, input + 9, length);
+                text[length] = 0x00;
+                hV_Screen_Buffer::gText(value[0], value[1], String(text), value[2], value[3]);
+                break;
+            }
+
             default:
 
-                _flag50 = false;
                 break;
         }
     }
+
+    bandReplaying = false;
+    _setOrientation(oldOrientation);
+    _penSolid = oldPenSolid;
+    f_fontSolid = oldFontSolid;
+    f_fontSize = oldFontSize;
+    f_fontSpaceX = oldFontSpaceX;
+    f_fontSpaceY = oldFontSpaceY;
 }
 
-void Screen_EPD_EXT3_Fast::COG_sendImageDataFast()
+uint8_t * Screen_EPD_EXT3_Fast::flush_record(uint8_t command, uint16_t size, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
 {
-    uint8_t * nextBuffer = u_newImage;
-    uint8_t * previousBuffer = u_newImage + u_pageColourSize;
-
-    if (_flag152 == true)
-    {
-        b_sendIndexData(0x24, previousBuffer, u_frameSize); // Previous frame
-        b_sendIndexData(0x26, nextBuffer, u_frameSize); // Next frame
-    }
-    else
+    uint32_t total = 8 + size;
+    if (listUsed + total > listSize)
     {
-        b_sendIndexData(0x10, previousBuffer, u_frameSize); // Previous frame
-        b_sendIndexData(0x13, nextBuffer, u_frameSize); // Next frame
+        listDropped++;
+        return 0; // full
     }
-    memcpy(previousBuffer, nextBuffer, u_frameSize); // Copy displayed next to previous
+
+    // Physical rows of the bounding box, clipped to screen
+    int32_t sizeX = screenSizeX();
+    int32_t sizeY = screenSizeY();
+    uint16_t cornerX1 = constrain(min(x1, x2), 0, sizeX - 1);
+    uint16_t cornerY1 = constrain(min(y1, y2), 0, sizeY - 1);
+    uint16_t cornerX2 = constrain(max(x1, x2), 0, sizeX - 1);
+    uint16_t cornerY2 = constrain(max(y1, y2), 0, sizeY - 1);
+    _orientCoordinates(cornerX1, cornerY1);
+    _orientCoordinates(cornerX2, cornerY2);
+    uint16_t rowFirst = min(cornerX1, cornerX2);
+    uint16_t rowLast = max(cornerX1, cornerX2);
+
+    uint8_t state = _orientation;
+    state |= _penSolid ? LIST_STATE_PEN_SOLID : 0;
+    state |= f_fontSolid ? LIST_STATE_FONT_SOLID : 0;
+
+    uint8_t * output = listData + listUsed;
+    output[0] = command;
+    output[1] = state;
+    output[2] = total & 0xff;
+    output[3] = total >> 8;
+    output[4] = rowFirst & 0xff;
+    output[5] = rowFirst >> 8;
+    output[6] = rowLast & 0xff;
+    output[7] = rowLast >> 8;
+
+    listUsed += total;
+    flushDirty = true;
+    return output + 8;
 }
 
-void Screen_EPD_EXT3_Fast::COG_update(uint8_t updateMode)
+void Screen_EPD_EXT3_Fast::flush_scanRows()
 {
-    if (_flag152 == true)
+    if (flushDirty == false)
     {
-        b_waitBusy(LOW); // 150 specific
-        b_sendCommand8(0x20); // Display Refresh
-        digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
-        b_waitBusy(LOW); // 150 specific
+        return;
     }
-    else
+
+    for (uint16_t row = 0; row < u_bufferSizeV; row++)
     {
-        // Specific settings for fast update, 154 213 266 and 370 screens (_flag50)
-        if ((u_codeExtra & FEATURE_FAST) and (updateMode != UPDATE_GLOBAL) and _flag50)
+        flushRow_s & meta = flushRows[row];
+        if ((meta.flags & FLUSH_ROW_DIRTY) == 0)
         {
-            index50b_work[0] = index50b_data[0]; // 0x07
-            b_sendIndexData(0x50, index50b_work, 1); // Vcom and data interval setting
+            continue;
         }
 
-        b_sendCommand8(0x04); // Power on
-        digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
-        b_waitBusy();
+        const uint8_t * next = flush_row(row, 0);
+        const uint8_t * previous = flush_row(row, 1);
 
-        b_sendCommand8(0x12); // Display Refresh
-        digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
-        b_waitBusy();
+        // Hash and uniform value in one pass
+        bool uniform = true;
+        for (uint16_t index = 1; index < u_bufferSizeH; index++)
+        {
+            if (next[index] != next[0])
+            {
+                uniform = false;
+                break;
+            }
+        }
+        meta.hash[0] = flush_hashRow(next);
+        meta.value[0] = next[0];
+        meta.flags &= ~(FLUSH_ROW_DIRTY | FLUSH_ROW_CHANGED | FLUSH_ROW_UNIFORM);
+        if (uniform)
+        {
+            meta.flags |= FLUSH_ROW_UNIFORM;
+        }
+
+        // Different hashes mean changed, same hashes are confirmed
+        bool changed;
+        if (meta.hash[0] != meta.hash[1])
+        {
+            changed = true;
+        }
+        else if (uniform and (meta.flags & FLUSH_ROW_UNIFORM_PREVIOUS))
+        {
+            changed = (meta.value[0] != meta.value[1]);
+        }
+        else
+        {
+            changed = (memcmp(next, previous, u_bufferSizeH) != 0);
+        }
+
+        if (changed)
+        {
+            meta.flags |= FLUSH_ROW_CHANGED;
+        }
     }
 }
 
-void Screen_EPD_EXT3_Fast::COG_powerOff()
+void Screen_EPD_EXT3_Fast::flush_sendRows(uint8_t index, uint8_t page, uint16_t fillFirst, uint16_t fillLast, uint8_t fill)
 {
-    if (_flag152 == true)
-    {
-        // Empty
-    }
-    else
+    // Rows contiguous in memory are sent in one block, inverted if needed
+    uint8_t uniform = (page == 0) ? FLUSH_ROW_UNIFORM : FLUSH_ROW_UNIFORM_PREVIOUS;
+    uint8_t mask = ((page == 0) ? u_invert : flushInvertPrevious) ? 0xff : 0x00;
+    const uint8_t * block = u_newImage;
+    uint32_t size = 0;
+
+    b_beginIndexData(index);
+    flushSending = true;
+    for (uint16_t row = 0; row < u_bufferSizeV; row++)
     {
-        b_sendCommand8(0x02); // Turn off DC/DC
-        digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
-        b_waitBusy();
+        bool fixed = ((row >= fillFirst) and (row < fillLast));
+        if (fixed or (flushRows[row].flags & uniform))
+        {
+            b_sendData(block, size, mask);
+            b_sendDataFixed(fixed ? fill : flushRows[row].value[page] ^ mask, u_bufferSizeH);
+            size = 0;
+        }
+        else
+        {
+            const uint8_t * data = flush_row(row, page);
+            if ((data == flushScratch) or (flushStorage != 0))
+            {
+                // Rebuilt previous row or cached row, sent before next rebuild or eviction
+                b_sendData(block, size, mask);
+                b_sendData(data, u_bufferSizeH, mask);
+                size = 0;
+                continue;
+            }
+            if (data != block + size)
+            {
+                b_sendData(block, size, mask);
+                block = data;
+                size = 0;
+            }
+            size += u_bufferSizeH;
+        }
     }
+    b_sendData(block, size, mask);
+    flushSending = false;
+    b_endIndexData();
 }
-/// @endcond
-//
-// === End of COG section
-//
 
-//
-// === Class section
-//
-Screen_EPD_EXT3_Fast::Screen_EPD_EXT3_Fast(eScreen_EPD_EXT3_t eScreen_EPD_EXT3, pins_t board) :
-    flushPending(false), flushState(kReady), nextBusyPinState(false)
+uint8_t * Screen_EPD_EXT3_Fast::flush_row(uint16_t row, uint8_t page, uint8_t access)
 {
-    u_eScreen_EPD_EXT3 = eScreen_EPD_EXT3;
-    b_pin = board;
-    u_newImage = 0; // nullptr
+    uint8_t flags = flushRows[row].flags;
+    if (flushSinglePage)
+    {
+        // Single page, previous row rebuilt once the row is drawn
+        if ((page == 1) and ((flags & FLUSH_ROW_STALE) == 0))
+        {
+            return flush_previousRow(row);
+        }
+        return u_newImage + (uint32_t)row * u_bufferSizeH;
+    }
+
+    // Outdated next row reads as previous row
+    if (flags & FLUSH_ROW_STALE)
+    {
+        page = 1;
+    }
+    bool second = ((flags & FLUSH_ROW_PAGE) != 0) xor (page == 1);
+    if (flushStorage != 0)
+    {
+        // Storage mode, row from the row cache
+        return flush_cacheRow((second ? u_pageColourSize : 0) + (uint32_t)row * u_bufferSizeH, access);
+    }
+    return u_newImage + (second ? u_pageColourSize : 0) + (uint32_t)row * u_bufferSizeH;
 }
 
-void Screen_EPD_EXT3_Fast::begin()
+uint8_t * Screen_EPD_EXT3_Fast::flush_cacheRow(uint32_t address, uint8_t access)
 {
-    u_codeExtra = (u_eScreen_EPD_EXT3 >> 16) & 0xff;
-    u_codeSize = (u_eScreen_EPD_EXT3 >> 8) & 0xff;
-    u_codeType = u_eScreen_EPD_EXT3 & 0xff;
-    _screenColourBits = 2; // BWR and BWRY
+    // Most recently used line first, then all lines
+    uint16_t found = rowLast;
+    if (rowLines[found].address != address)
+    {
+        uint16_t oldest = 0;
+        found = rowLineCount;
+        for (uint16_t line = 0; line < rowLineCount; line++)
+        {
+            if (rowLines[line].address == address)
+            {
+                found = line;
+                break;
+            }
+            if (rowLines[line].used < rowLines[oldest].used)
+            {
+                oldest = line;
+            }
+        }
 
-    _flag152 = ((u_codeSize == 0x15) and (u_codeType == 0x4A));
+        if (found == rowLineCount)
+        {
+            // Least recently used line replaced, written back if modified
+            // Panel released while the storage shares the SPI bus
+            found = oldest;
+            flushLine_s & victim = rowLines[found];
+            uint8_t * data = rowData + (uint32_t)found * u_bufferSizeH;
+            if (flushSending and flushStorage->isExternal())
+            {
+                digitalWrite(b_pin.panelCS, HIGH);
+            }
+            if (victim.dirty)
+            {
+                flushStorage->write(victim.address, data, u_bufferSizeH);
+                rowCache.writeBacks++;
+            }
+            if (access != FLUSH_ACCESS_WHOLE)
+            {
+                flushStorage->read(address, data, u_bufferSizeH);
+            }
+            if (flushSending and flushStorage->isExternal())
+            {
+                digitalWrite(b_pin.panelCS, LOW);
+            }
+            victim.address = address;
+            victim.dirty = false;
+            rowCache.misses++;
+        }
+        else
+        {
+            rowCache.hits++;
+        }
+    }
+    else
+    {
+        rowCache.hits++;
+    }
 
-    // Configure board
-    switch (u_codeSize)
+    rowLast = found;
+    rowLines[found].used = ++rowClock;
+    if (access & FLUSH_ACCESS_WRITE)
     {
-        case 0x58: // 5.81"
-        case 0x74: // 7.41"
+        rowLines[found].dirty = true;
+    }
+    return rowData + (uint32_t)found * u_bufferSizeH;
+}
 
-            b_begin(b_pin, FAMILY_MEDIUM, 50);
-            break;
+uint8_t * Screen_EPD_EXT3_Fast::flush_previousRow(uint16_t row)
+{
+    // Single page, row drawn since last upload
+    const flushRow_s & meta = flushRows[row];
+    if (meta.flags & FLUSH_ROW_SAVED)
+    {
+        for (uint16_t slot = 0; slot < flushSavedCount; slot++)
+        {
+            uint8_t * data = flushSaved + (uint32_t)slot * (u_bufferSizeH + 2);
+            if ((data[0] | (data[1] << 8)) == row)
+            {
+                return data + 2;
+            }
+        }
+    }
 
-        default:
+    if (meta.flags & FLUSH_ROW_UNIFORM_PREVIOUS)
+    {
+        memset(flushScratch, meta.value[1], u_bufferSizeH);
+    }
+    else if (flushCompressed)
+    {
+        // Rows decoded in increasing order, from the start otherwise
+        uint32_t chrono = micros();
+        if (row < flushCursorRow)
+        {
+            flushCursorRow = 0;
+            flushCursorOffset = 0;
+        }
+        while (flushCursorRow < row)
+        {
+            if ((flushRows[flushCursorRow].flags & FLUSH_ROW_UNIFORM_PREVIOUS) == 0)
+            {
+                flush_decodeRow(0); // skipped
+            }
+            flushCursorRow++;
+        }
+        flush_decodeRow(flushScratch);
+        flushCursorRow++;
+        flushCompressionInfo.decodeTime += micros() - chrono;
+    }
+    else
+    {
+        // Previous row lost, all pixels toggled, as sent with inversion
+        const uint8_t * next = u_newImage + (uint32_t)row * u_bufferSizeH;
+        uint8_t inverted = (u_invert != flushInvertPrevious) ? 0xff : 0x00;
+        for (uint16_t index = 0; index < u_bufferSizeH; index++)
+        {
+            flushScratch[index] = ~next[index] ^ inverted;
+        }
+    }
+    return flushScratch;
+}
 
-            b_begin(b_pin, FAMILY_SMALL, 50);
-            break;
+void Screen_EPD_EXT3_Fast::flush_compress()
+{
+    flushCompressed = false;
+    flushCursorRow = 0;
+    flushCursorOffset = 0;
+    flushCompressionInfo.compressedSize = 0;
+    flushCompressionInfo.ratio = 0;
+    if (not flushCompression)
+    {
+        return;
     }
 
-    switch (u_codeSize)
+    // Run-length encoding of the non-uniform rows, runs within one row
+    // Control byte 0x00..0x7f = 1..128 literal bytes, 0x80..0xff = run of 2..129 bytes
+    uint32_t chrono = micros();
+    uint32_t size = 0;
+    for (uint16_t row = 0; row < u_bufferSizeV; row++)
     {
-        case 0x15: // 1.54"
+        if (flushRows[row].flags & FLUSH_ROW_UNIFORM_PREVIOUS)
+        {
+            continue;
+        }
 
-            if (_flag152)
+        const uint8_t * data = u_newImage + (uint32_t)row * u_bufferSizeH;
+        uint16_t index = 0;
+        while (index < u_bufferSizeH)
+        {
+            uint16_t count = 1;
+            while ((index + count < u_bufferSizeH) and (count < 129) and (data[index + count] == data[index]))
             {
-                _screenSizeV = 200; // vertical = wide size
-                _screenSizeH = 200; // horizontal = small size
-                _screenDiagonal = 152;
+                count++;
+            }
 
+            if (count > 1)
+            {
+                if (size + 2 > flushPoolSize)
+                {
+                    return; // too large, saved rows instead
+                }
+                flushSaved[size++] = 0x80 | (count - 2);
+                flushSaved[size++] = data[index];
             }
             else
             {
-                _screenSizeV = 152; // vertical = wide size
-                _screenSizeH = 152; // horizontal = small size
-                _screenDiagonal = 154;
+                // Literal bytes up to the next run
+                while ((index + count < u_bufferSizeH) and (count < 128) and
+                        ((index + count + 1 == u_bufferSizeH) or (data[index + count] != data[index + count + 1])))
+                {
+                    count++;
+                }
+                if (size + 1 + count > flushPoolSize)
+                {
+                    return; // too large, saved rows instead
+                }
+                flushSaved[size++] = count - 1;
+                memcpy(flushSaved + size, data + index, count);
+                size += count;
             }
-            break;
-
-        case 0x20: // 2.06"
+            index += count;
+        }
+    }
 
-            _screenSizeV = 248; // vertical = wide size
-            _screenSizeH = 128; // horizontal = small size
-            _screenDiagonal = 206;
-            break;
+    flushCompressed = true;
+    flushCompressionInfo.compressedSize = size;
+    uint32_t ratio = (uint64_t)u_pageColourSize * 100 / ((size > 0) ? size : 1);
+    flushCompressionInfo.ratio = (ratio > UINT16_MAX) ? UINT16_MAX : ratio;
+    flushCompressionInfo.encodeTime = micros() - chrono;
+}
 
-        case 0x21: // 2.13"
+void Screen_EPD_EXT3_Fast::flush_decodeRow(uint8_t * data)
+{
+    // One row from the cursor, skipped if data is 0
+    const uint8_t * input = flushSaved + flushCursorOffset;
+    uint16_t index = 0;
+    while (index < u_bufferSizeH)
+    {
+        uint8_t control = *input++;
+        uint16_t count;
+        if (control & 0x80)
+        {
+            count = (control & 0x7f) + 2;
+            if (data != 0)
+            {
+                memset(data + index, *input, count);
+            }
+            input++;
+        }
+        else
+        {
+            count = control + 1;
+            if (data != 0)
+            {
+                memcpy(data + index, input, count);
+            }
+            input += count;
+        }
+        index += count;
+    }
+    flushCursorOffset = input - flushSaved;
+}
 
-            _screenSizeV = 212; // vertical = wide size
-            _screenSizeH = 104; // horizontal = small size
-            _screenDiagonal = 213;
-            break;
+void Screen_EPD_EXT3_Fast::flush_touchRow(uint16_t row, bool whole)
+{
+    // Copy on first write, unless the whole row is written
+    flushRow_s & meta = flushRows[row];
+    if ((meta.flags & FLUSH_ROW_STALE) == 0)
+    {
+        return;
+    }
 
-        case 0x26: // 2.66"
-
-            _screenSizeV = 296; // vertical = wide size
-            _screenSizeH = 152; // horizontal = small size
-            _screenDiagonal = 266;
-            break;
+    if (flushSinglePage)
+    {
+        // Previous row saved before first write, unless uniform or compressed
+        if (((meta.flags & FLUSH_ROW_UNIFORM_PREVIOUS) == 0) and (not flushCompressed))
+        {
+            if (flushSavedCount < flushSavedSlots)
+            {
+                uint8_t * data = flushSaved + (uint32_t)flushSavedCount * (u_bufferSizeH + 2);
+                data[0] = row & 0xff;
+                data[1] = row >> 8;
+                memcpy(data + 2, u_newImage + (uint32_t)row * u_bufferSizeH, u_bufferSizeH);
+                flushSavedCount++;
+                meta.flags |= FLUSH_ROW_SAVED;
+            }
+            else
+            {
+                meta.flags |= FLUSH_ROW_LOST;
+                flushLost++;
+            }
+        }
+        meta.flags &= ~FLUSH_ROW_STALE;
+    }
+    else
+    {
+        const uint8_t * previous = flush_row(row, 1);
+        meta.flags &= ~FLUSH_ROW_STALE;
+        if (not whole)
+        {
+            memcpy(flush_row(row, 0, FLUSH_ACCESS_WHOLE), previous, u_bufferSizeH);
+        }
+    }
+}
 
-        case 0x27: // 2.71" and 2.71"-Touch
+uint16_t Screen_EPD_EXT3_Fast::flush_hashRow(const uint8_t * data)
+{
+    // djb2, truncated to 16 bits
+    uint16_t hash = 5381;
+    for (uint16_t index = 0; index < u_bufferSizeH; index++)
+    {
+        hash = (hash << 5) + hash + data[index];
+    }
+    return hash;
+}
 
-            _screenSizeV = 264; // vertical = wide size
-            _screenSizeH = 176; // horizontal = small size
-            _screenDiagonal = 271;
-            break;
+void Screen_EPD_EXT3_Fast::flush_uploadTiles(uint8_t indexPrevious, uint8_t indexNext)
+{
+    // Tiles back to uniform released
+    flush_collapseTiles();
+    flushDirty = false;
 
-        case 0x28: // 2.87"
+    flush_sendTiles(indexPrevious, 1, flushInvertPrevious ? 0xff : 0x00); // Previous frame
+    flush_sendTiles(indexNext, 0, u_invert ? 0xff : 0x00); // Next frame
 
-            _screenSizeV = 296; // vertical = wide size
-            _screenSizeH = 128; // horizontal = small size
-            _screenDiagonal = 287;
-            break;
+    // Count toggled pixels by region, tiles drawn since last upload or all tiles if the inversion has changed
+    uint8_t inverted = (u_invert != flushInvertPrevious) ? 0xff : 0x00;
+    flushChangedBytes = 0;
+    for (uint16_t index = 0; index < tilesH * tilesV; index++)
+    {
+        const flushTile_s & tile = flushTiles[index];
+        if ((tile.flags & FLUSH_TILE_STALE) and (inverted == 0x00))
+        {
+            continue;
+        }
 
-        case 0x29: // 2.90"
+        uint16_t rowFirst = (index / tilesH) * FLUSH_TILE_SIZE;
+        uint16_t rowLast = min((uint16_t)(rowFirst + FLUSH_TILE_SIZE), u_bufferSizeV);
+        uint16_t byteFirst = (index % tilesH) * (FLUSH_TILE_SIZE / 8);
+        uint16_t width = min((uint16_t)(FLUSH_TILE_SIZE / 8), (uint16_t)(u_bufferSizeH - byteFirst));
+        for (uint16_t row = rowFirst; row < rowLast; row++)
+        {
+            uint32_t toggles = 0;
+            for (uint16_t offset = 0; offset < width; offset++)
+            {
+                uint16_t position = (row - rowFirst) * (FLUSH_TILE_SIZE / 8) + offset;
+                uint8_t toggled = flush_tileByte(tile, 1, position) ^ flush_tileByte(tile, 0, position) ^ inverted;
+                if (toggled)
+                {
+                    toggles += __builtin_popcount(toggled);
+                    flushChangedBytes++;
+                }
+            }
+            flushToggles[(uint32_t)row * FLUSH_REGIONS / u_bufferSizeV] += toggles;
+        }
+    }
+    flushInvertPrevious = u_invert;
 
-            _screenSizeV = 384; // vertical = wide size
-            _screenSizeH = 168; // horizontal = small size
-            _screenDiagonal = 290;
-            break;
+    // Next tiles become previous tiles, slots of replaced previous tiles released
+    for (uint16_t index = 0; index < tilesH * tilesV; index++)
+    {
+        flushTile_s & tile = flushTiles[index];
+        if (tile.flags & FLUSH_TILE_STALE)
+        {
+            continue;
+        }
 
-        case 0x37: // 3.70" and 3.70"-Touch
+        if (tile.slot[1] != FLUSH_TILE_UNIFORM)
+        {
+            flush_releaseTile(tile.slot[1]);
+        }
+        tile.slot[1] = tile.slot[0];
+        tile.value[1] = tile.value[0];
+        tile.flags |= FLUSH_TILE_STALE;
+    }
 
-            _screenSizeV = 416; // vertical = wide size
-            _screenSizeH = 240; // horizontal = small size
-            _screenDiagonal = 370;
-            break;
+    if (flushUpdateMode == UPDATE_GLOBAL)
+    {
+        // Global update clears ghosting
+        memset(flushToggles, 0x00, sizeof(flushToggles));
+    }
+}
 
-        case 0x41: // 4.17"
+void Screen_EPD_EXT3_Fast::flush_sendTiles(uint8_t index, uint8_t page, uint8_t mask)
+{
+    // Consecutive uniform tiles of the same value sent in one fixed block
+    uint8_t fixedValue = 0x00;
+    uint32_t fixedSize = 0;
 
-            _screenSizeV = 300; // vertical = wide size
-            _screenSizeH = 400; // horizontal = small size
-            _screenDiagonal = 417;
-            break;
+    b_beginIndexData(index);
+    for (uint16_t row = 0; row < u_bufferSizeV; row++)
+    {
+        const flushTile_s * tiles = flushTiles + (row / FLUSH_TILE_SIZE) * tilesH;
+        uint16_t position = (row % FLUSH_TILE_SIZE) * (FLUSH_TILE_SIZE / 8);
+        for (uint16_t column = 0; column < tilesH; column++)
+        {
+            const flushTile_s & tile = tiles[column];
+            uint8_t source = (tile.flags & FLUSH_TILE_STALE) ? 1 : page;
+            uint16_t width = min((uint16_t)(FLUSH_TILE_SIZE / 8), (uint16_t)(u_bufferSizeH - column * (FLUSH_TILE_SIZE / 8)));
+            if (tile.slot[source] == FLUSH_TILE_UNIFORM)
+            {
+                if ((fixedSize > 0) and (tile.value[source] != fixedValue))
+                {
+                    b_sendDataFixed(fixedValue ^ mask, fixedSize);
+                    fixedSize = 0;
+                }
+                fixedValue = tile.value[source];
+                fixedSize += width;
+            }
+            else
+            {
+                b_sendDataFixed(fixedValue ^ mask, fixedSize);
+                fixedSize = 0;
+                b_sendData(tilePool + (uint32_t)tile.slot[source] * FLUSH_TILE_BYTES + position, width, mask);
+            }
+        }
+    }
+    b_sendDataFixed(fixedValue ^ mask, fixedSize);
+    b_endIndexData();
+}
 
-        case 0x43: // 4.37"
+uint8_t Screen_EPD_EXT3_Fast::flush_tileByte(const flushTile_s & tile, uint8_t page, uint16_t offset)
+{
+    // Outdated next tile reads as previous tile
+    if (tile.flags & FLUSH_TILE_STALE)
+    {
+        page = 1;
+    }
+    if (tile.slot[page] == FLUSH_TILE_UNIFORM)
+    {
+        return tile.value[page];
+    }
+    return tilePool[(uint32_t)tile.slot[page] * FLUSH_TILE_BYTES + offset];
+}
 
-            _screenSizeV = 480; // vertical = wide size
-            _screenSizeH = 176; // horizontal = small size
-            _screenDiagonal = 437;
-            break;
+uint8_t * Screen_EPD_EXT3_Fast::flush_touchTile(uint16_t index)
+{
+    // Next tile materialised on first write, from previous tile if outdated
+    flushTile_s & tile = flushTiles[index];
+    uint8_t page = (tile.flags & FLUSH_TILE_STALE) ? 1 : 0;
+    if ((page == 0) and (tile.slot[0] != FLUSH_TILE_UNIFORM))
+    {
+        return tilePool + (uint32_t)tile.slot[0] * FLUSH_TILE_BYTES;
+    }
 
-        case 0x56: // 5.65"
+    uint16_t slot = flush_allocateTile();
+    if (slot == FLUSH_TILE_UNIFORM)
+    {
+        tileDropped++;
+        return 0;
+    }
 
-            _screenSizeV = 600; // v = wide size
-            _screenSizeH = 448; // h = small size
-            _screenDiagonal = 565;
-            break;
+    uint8_t * data = tilePool + (uint32_t)slot * FLUSH_TILE_BYTES;
+    if (tile.slot[page] == FLUSH_TILE_UNIFORM)
+    {
+        memset(data, tile.value[page], FLUSH_TILE_BYTES);
+    }
+    else
+    {
+        memcpy(data, tilePool + (uint32_t)tile.slot[page] * FLUSH_TILE_BYTES, FLUSH_TILE_BYTES);
+    }
+    tile.slot[0] = slot;
+    tile.flags &= ~FLUSH_TILE_STALE;
+    return data;
+}
 
-        case 0x58: // 5.81"
+void Screen_EPD_EXT3_Fast::flush_setTile(uint16_t index, uint8_t value)
+{
+    // Next tile uniform, slot released
+    flushTile_s & tile = flushTiles[index];
+    if (((tile.flags & FLUSH_TILE_STALE) == 0) and (tile.slot[0] != FLUSH_TILE_UNIFORM))
+    {
+        flush_releaseTile(tile.slot[0]);
+    }
+    tile.slot[0] = FLUSH_TILE_UNIFORM;
+    tile.value[0] = value;
+    tile.flags &= ~FLUSH_TILE_STALE;
+}
 
-            _screenSizeV = 720; // v = wide size
-            _screenSizeH = 256; // h = small size
-            _screenDiagonal = 581;
-            break;
+uint16_t Screen_EPD_EXT3_Fast::flush_allocateTile()
+{
+    // Tiles back to uniform released when the tile pool is full
+    if ((tileFree == FLUSH_TILE_UNIFORM) and (flush_collapseTiles() == 0))
+    {
+        return FLUSH_TILE_UNIFORM;
+    }
 
-        case 0x74: // 7.40"
+    uint16_t slot = tileFree;
+    const uint8_t * data = tilePool + (uint32_t)slot * FLUSH_TILE_BYTES;
+    tileFree = data[0] | (data[1] << 8);
+    tileUsed++;
+    if (tileUsed > tilePeak)
+    {
+        tilePeak = tileUsed;
+    }
+    return slot;
+}
 
-            _screenSizeV = 800; // v = wide size
-            _screenSizeH = 480; // h = small size
-            _screenDiagonal = 741;
-            break;
+void Screen_EPD_EXT3_Fast::flush_releaseTile(uint16_t slot)
+{
+    uint8_t * data = tilePool + (uint32_t)slot * FLUSH_TILE_BYTES;
+    data[0] = tileFree & 0xff;
+    data[1] = tileFree >> 8;
+    tileFree = slot;
+    tileUsed--;
+}
 
-        default:
+uint16_t Screen_EPD_EXT3_Fast::flush_collapseTiles()
+{
+    // Next tiles drawn since last upload and back to one single byte value
+    uint16_t released = 0;
+    for (uint16_t index = 0; index < tilesH * tilesV; index++)
+    {
+        const flushTile_s & tile = flushTiles[index];
+        if ((tile.flags & FLUSH_TILE_STALE) or (tile.slot[0] == FLUSH_TILE_UNIFORM))
+        {
+            continue;
+        }
 
-            break;
-    } // u_codeSize
+        const uint8_t * data = tilePool + (uint32_t)tile.slot[0] * FLUSH_TILE_BYTES;
+        uint16_t rows = min((uint16_t)FLUSH_TILE_SIZE, (uint16_t)(u_bufferSizeV - (index / tilesH) * FLUSH_TILE_SIZE));
+        uint16_t width = min((uint16_t)(FLUSH_TILE_SIZE / 8), (uint16_t)(u_bufferSizeH - (index % tilesH) * (FLUSH_TILE_SIZE / 8)));
+        bool uniform = true;
+        for (uint16_t row = 0; (row < rows) and uniform; row++)
+        {
+            for (uint16_t offset = 0; offset < width; offset++)
+            {
+                if (data[row * (FLUSH_TILE_SIZE / 8) + offset] != data[0])
+                {
+                    uniform = false;
+                    break;
+                }
+            }
+        }
 
-    u_bufferDepth = _screenColourBits; // 2 colours
-    u_bufferSizeV = _screenSizeV; // vertical = wide size
-    u_bufferSizeH = _screenSizeH / 8; // horizontal = small size 112 / 8, 1 bit per pixel
+        if (uniform)
+        {
+            flush_setTile(index, data[0]);
+            released++;
+        }
+    }
+    return released;
+}
 
-    // Force conversion for two unit16_t multiplication into uint32_t.
-    // Actually for 1 colour; BWR requires 2 pages.
-    u_pageColourSize = (uint32_t)u_bufferSizeV * (uint32_t)u_bufferSizeH;
+void Screen_EPD_EXT3_Fast::COG_sendImageDataRegion()
+{
+    // Displayed image with the region forced black then white, previous page unchanged
+    // Phase 1: displayed to black, 2: black to white, 3: white to displayed
+    uint16_t first = (uint32_t)u_bufferSizeV * flushMaintenanceRegion / FLUSH_REGIONS;
+    uint16_t last = (uint32_t)u_bufferSizeV * (flushMaintenanceRegion + 1) / FLUSH_REGIONS;
 
-    // u_frameSize = u_pageColourSize, except for 9.69 and 11.98
-    // 9.69 and 11.98 combine two half-screens, hence two frames with adjusted size
-    switch (u_codeSize)
+    for (uint8_t page = 0; page < 2; page++)
     {
-        case 0x96: // 9.69"
-        case 0xB9: // 11.98"
+        uint8_t phase = flushMaintenance + page - 1; // 0 = displayed, 1 = black, 2 = white, 3 = displayed
+        uint8_t index;
 
-            u_frameSize = u_pageColourSize / 2;
-            break;
+        if (_panel.flag152 == true)
+        {
+            index = (page == 0) ? 0x24 : 0x26;
+        }
+        else
+        {
+            index = (page == 0) ? 0x10 : 0x13;
+        }
 
-        default:
+        if ((phase == 0) or (phase == 3))
+        {
+            flush_sendRows(index, 1);
+        }
+        else
+        {
+            flush_sendRows(index, 1, first, last, (phase == 1) ? 0xff : 0x00);
+        }
+    }
+}
 
-            u_frameSize = u_pageColourSize;
-            break;
-    } // u_codeSize
+void Screen_EPD_EXT3_Fast::COG_update(uint8_t updateMode)
+{
+    if (_panel.flag152 == true)
+    {
+        // Empty
+    }
+    else
+    {
+        // Specific settings for fast update, 154 213 266 and 370 screens (_panel.flag50)
+        if ((u_codeExtra & FEATURE_FAST) and (updateMode != UPDATE_GLOBAL) and _panel.flag50)
+        {
+            index50b_work[0] = index50b_data[0]; // 0x07
+            b_sendIndexData(0x50, index50b_work, 1); // Vcom and data interval setting
+        }
 
-#if defined(BOARD_HAS_PSRAM) // ESP32 PSRAM specific case
+        b_sendCommand8(0x04); // Power on
+        digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
+    }
+}
 
-    if (u_newImage == 0)
+void Screen_EPD_EXT3_Fast::COG_refresh()
+{
+    if (_panel.flag152 == true)
+    {
+        b_sendCommand8(0x20); // Display Refresh
+        digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
+    }
+    else
     {
-        static uint8_t * _newFrameBuffer;
-        _newFrameBuffer = (uint8_t *) ps_malloc(u_pageColourSize * u_bufferDepth);
-        u_newImage = (uint8_t *) _newFrameBuffer;
+        b_sendCommand8(0x12); // Display Refresh
+        digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
     }
+}
 
-#else // default case
+void Screen_EPD_EXT3_Fast::COG_powerOff()
+{
+    if (_panel.flag152 == true)
+    {
+        // Empty
+    }
+    else
+    {
+        b_sendCommand8(0x02); // Turn off DC/DC
+        digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
+    }
+}
+/// @endcond
+//
+// === End of COG section
+//
+
+//
+// === Class section
+//
+Screen_EPD_EXT3_Fast::Screen_EPD_EXT3_Fast(eScreen_EPD_EXT3_t eScreen_EPD_EXT3, pins_t board) :
+    flushPending(false), flushPendingMode(UPDATE_FAST), flushRegenerate(0), flushRegenerateSequence(0),
+    flushState(kReady), nextBusyPinState(false),
+    flushPolicy(FLUSH_POLICY_LATEST), flushInterval(0), flushDeadline(0), flushTarget(0), flushCurrentDeadline(0),
+    flushUploaded(false), flushStartTime(0), flushVisibleTime(0), flushEndTime(0), flushDuration(0), flushLatency(0),
+    flushUploadedCallback(0), flushVisibleCallback(0), flushUpdateMode(UPDATE_FAST), flushSequence(0), flushCompleted(0)
+#if (WORKER_MODE != USE_WORKER_NONE)
+    , flushQueueHead(0), flushQueueTail(0), flushPosted(0), flushServed(0), flushWorkerRunning(false)
+#endif // WORKER_MODE
+{
+    u_eScreen_EPD_EXT3 = eScreen_EPD_EXT3;
+    _panel = panelDescriptor(eScreen_EPD_EXT3);
+    b_pin = board;
+    u_newImage = 0; // nullptr
+    flushRows = 0; // nullptr
+    cacheSlots = 0; // nullptr
+    cacheData = 0; // nullptr
+    cacheSlotCount = 0;
+    cacheClock = 0;
+    surfaceArena = 0; // nullptr
+    surfaceArenaSize = 0;
+    surfaceUsed = 0;
+    surfacePeak = 0;
+    for (uint8_t index = 0; index < FLUSH_LAYERS; index++)
+    {
+        flushLayers[index] = {0, 0, LAYER_NONE};
+    }
+    layerTarget = 0; // nullptr
+    layerFirst = 0xffff;
+    layerLast = 0;
+    flushDirty = false;
+    flushInvertPrevious = false;
+    flushChangedBytes = 0;
+    flushSinglePage = false;
+    flushScratch = 0; // nullptr
+    flushSaved = 0; // nullptr
+    flushSavedSlots = 0;
+    flushSavedCount = 0;
+    flushLost = 0;
+    flushPoolSize = 0;
+    flushCompression = false;
+    flushCompressed = false;
+    flushCursorRow = 0;
+    flushCursorOffset = 0;
+    memset(&flushCompressionInfo, 0x00, sizeof(flushCompressionInfo));
+    bandBuffer = 0; // nullptr
+    bandRows = 0;
+    bandFirst = 0;
+    bandLast = 0;
+    bandReplaying = false;
+    listData = 0; // nullptr
+    listSize = 0;
+    listUsed = 0;
+    listStart = 0;
+    listDisplayed = 0;
+    listDropped = 0;
+    listRasterTime = 0;
+    flushTiled = false;
+    flushTiles = 0; // nullptr
+    tilePool = 0; // nullptr
+    tilesH = 0;
+    tilesV = 0;
+    tileSlots = 0;
+    tileFree = FLUSH_TILE_UNIFORM;
+    tileUsed = 0;
+    tilePeak = 0;
+    tileDropped = 0;
+    flushStorage = 0; // nullptr
+    rowLines = 0; // nullptr
+    rowData = 0; // nullptr
+    rowLineCount = 0;
+    rowLast = 0;
+    rowClock = 0;
+    flushSending = false;
+    memset(&rowCache, 0x00, sizeof(rowCache));
+    _setOrientation(0);
+    resetFlushStatistics();
+    memset(flushTimestamps, 0x00, sizeof(flushTimestamps));
+    memset(flushMetrics, 0x00, sizeof(flushMetrics));
+    flushBand = FLUSH_BAND_NOMINAL;
+    memset(flushToggles, 0x00, sizeof(flushToggles));
+    flushGhostingThreshold = 0;
+    flushGhostingIdle = 1000;
+    flushMaintenance = 0;
+    flushMaintenanceRegion = 0;
+    flushMaintenanceSequence = 0;
+    flushVisibleTimestamp = 0;
+
+#if defined(__cpp_impl_coroutine)
+    for (uint8_t index = 0; index < FLUSH_AWAITERS; index++)
+    {
+        flushAwaiting[index] = nullptr;
+        flushAwaitingSequence[index] = 0;
+    }
+#endif // __cpp_impl_coroutine
+
+#if (WORKER_MODE != USE_WORKER_NONE)
+    flushTickets[0] = 0;
+    flushTickets[1] = 0;
+#if (WORKER_MODE == USE_WORKER_FREERTOS)
+    flushWorkerHandle = NULL;
+    flushWaiterHandle = NULL;
+#endif // WORKER_MODE
+#endif // WORKER_MODE
+}
+
+void Screen_EPD_EXT3_Fast::begin()
+{
+    u_codeExtra = (u_eScreen_EPD_EXT3 >> 16) & 0xff;
+    u_codeSize = (u_eScreen_EPD_EXT3 >> 8) & 0xff;
+    u_codeType = u_eScreen_EPD_EXT3 & 0xff;
+    _screenColourBits = 2; // BWR and BWRY
+
+    // Panel properties from descriptor
+    _screenSizeV = _panel.sizeV; // vertical = wide size
+    _screenSizeH = _panel.sizeH; // horizontal = small size
+    _screenDiagonal = _panel.diagonal;
+
+    // Configure board
+    b_begin(b_pin, _panel.family, 50);
+
+    u_bufferDepth = flushSinglePage ? 1 : _screenColourBits; // 2 colours, or single page
+    u_bufferSizeV = _screenSizeV; // vertical = wide size
+    u_bufferSizeH = _screenSizeH / 8; // horizontal = small size 112 / 8, 1 bit per pixel
 
-    if (u_newImage == 0)
+    // Force conversion for two unit16_t multiplication into uint32_t.
+    // Actually for 1 colour; BWR requires 2 pages.
+    u_pageColourSize = (uint32_t)u_bufferSizeV * (uint32_t)u_bufferSizeH;
+
+    // u_frameSize = u_pageColourSize, as 9.69 and 11.98 are not supported
+    u_frameSize = u_pageColourSize;
+
+    if (bandRows > 0)
+    {
+        // Banded mode, band buffer instead of frame-buffer
+        u_newImage = bandBuffer;
+        listUsed = 0;
+        listStart = 0;
+        listDisplayed = 0;
+        flushDirty = false;
+    }
+    else if (flushTiled)
     {
-        static uint8_t * _newFrameBuffer;
-        _newFrameBuffer = new uint8_t[u_pageColourSize * u_bufferDepth];
-        u_newImage = (uint8_t *) _newFrameBuffer;
+        // Tiled mode, all tiles uniform 0x00, all slots free
+        for (uint16_t index = 0; index < tilesH * tilesV; index++)
+        {
+            flushTiles[index].slot[0] = FLUSH_TILE_UNIFORM;
+            flushTiles[index].slot[1] = FLUSH_TILE_UNIFORM;
+            flushTiles[index].value[0] = 0x00;
+            flushTiles[index].value[1] = 0x00;
+            flushTiles[index].flags = FLUSH_TILE_STALE;
+        }
+        for (uint16_t slot = 0; slot < tileSlots; slot++)
+        {
+            uint16_t next = (slot + 1 < tileSlots) ? slot + 1 : FLUSH_TILE_UNIFORM;
+            tilePool[(uint32_t)slot * FLUSH_TILE_BYTES] = next & 0xff;
+            tilePool[(uint32_t)slot * FLUSH_TILE_BYTES + 1] = next >> 8;
+        }
+        tileFree = 0;
+        tileUsed = 0;
+        tilePeak = 0;
+        tileDropped = 0;
+        u_newImage = tilePool;
+        flushDirty = false;
     }
+    else
+    {
+        if (flushStorage != 0)
+        {
+            // Storage mode, row cache empty, storage cleared once SPI is initialised
+            u_newImage = rowData;
+            memset(rowData, 0x00, u_bufferSizeH);
+            for (uint16_t line = 0; line < rowLineCount; line++)
+            {
+                rowLines[line].address = FLUSH_LINE_EMPTY;
+                rowLines[line].used = 0;
+                rowLines[line].dirty = false;
+            }
+            rowLast = 0;
+            rowClock = 0;
+            memset(&rowCache, 0x00, sizeof(rowCache));
+            rowCache.lines = rowLineCount;
+        }
+        else
+        {
+#if defined(BOARD_HAS_PSRAM) // ESP32 PSRAM specific case
+
+            if (u_newImage == 0)
+            {
+                static uint8_t * _newFrameBuffer;
+                _newFrameBuffer = (uint8_t *) ps_malloc(u_pageColourSize * u_bufferDepth);
+                u_newImage = (uint8_t *) _newFrameBuffer;
+            }
+
+#else // default case
+
+            if (u_newImage == 0)
+            {
+                static uint8_t * _newFrameBuffer;
+                _newFrameBuffer = new uint8_t[u_pageColourSize * u_bufferDepth];
+                u_newImage = (uint8_t *) _newFrameBuffer;
+            }
 
 #endif // ESP32 BOARD_HAS_PSRAM
 
-    memset(u_newImage, 0x00, u_pageColourSize * u_bufferDepth);
+            memset(u_newImage, 0x00, u_pageColourSize * u_bufferDepth);
+        }
+
+        // Single page, scratch row and saved rows after the page
+        if (flushSinglePage)
+        {
+            flushScratch = u_newImage + u_pageColourSize;
+            flushSaved = flushScratch + u_bufferSizeH;
+            flushSavedCount = 0;
+            flushLost = 0;
+        }
+
+        // Single page, previous frame uniform 0x00, empty when compressed
+        flushCompressed = flushSinglePage and flushCompression;
+        flushCursorRow = 0;
+        flushCursorOffset = 0;
+        flushCompressionInfo.compressedSize = 0;
+        flushCompressionInfo.ratio = flushCompressed ? UINT16_MAX : 0;
+
+        // Row metadata, both pages uniform 0x00
+        // Single page, page row is also previous row
+        if (flushRows == 0)
+        {
+            flushRows = new flushRow_s[u_bufferSizeV];
+        }
+        uint16_t hashBlank = flush_hashRow(u_newImage);
+        for (uint16_t row = 0; row < u_bufferSizeV; row++)
+        {
+            flushRows[row].hash[0] = hashBlank;
+            flushRows[row].hash[1] = hashBlank;
+            flushRows[row].value[0] = 0x00;
+            flushRows[row].value[1] = 0x00;
+            flushRows[row].flags = FLUSH_ROW_UNIFORM | FLUSH_ROW_UNIFORM_PREVIOUS | (flushSinglePage ? FLUSH_ROW_STALE : 0);
+        }
+        flushDirty = false;
+    }
 
     // Initialise the /CS pins
     pinMode(b_pin.panelCS, OUTPUT);
@@ -566,29 +1527,17 @@ void Screen_EPD_EXT3_Fast::begin()
 #endif // ENERGIA
 
     // Reset
-    switch (u_codeSize)
+    if (_panel.family == FAMILY_MEDIUM)
     {
-        case 0x56: // 5.65"
-        case 0x58: // 5.81"
-        case 0x74: // 7.40"
-
-            b_reset(200, 20, 200, 50, 5); // medium
-            break;
-
-        case 0x96: // 9.69"
-        case 0xB9: // 11.98"
-
-            b_reset(200, 20, 200, 200, 5); // large
-            break;
-
-        default:
-
-            b_reset(5, 5, 10, 5, 5); // small
-            break;
-    } // u_codeSize
+        b_reset(200, 20, 200, 50, 5); // medium
+    }
+    else
+    {
+        b_reset(5, 5, 10, 5, 5); // small
+    } // _panel.family
 
     // Check after reset
-    if (_flag152 == true)
+    if (_panel.flag152 == true)
     {
         if (digitalRead(b_pin.panelBusy) == HIGH)
         {
@@ -598,9 +1547,6 @@ void Screen_EPD_EXT3_Fast::begin()
         }
     }
 
-    // Check type and get tables
-    COG_getUserData(); // nothing sent to panel
-
     // Standard
     hV_Screen_Buffer::begin();
 
@@ -613,6 +1559,21 @@ void Screen_EPD_EXT3_Fast::begin()
 
     _penSolid = false;
     u_invert = false;
+    flushInvertPrevious = false;
+    _resolveColour(myColours.black);
+
+    // Storage mode, previous page cleared row by row, next page cleared by clear()
+    if (flushStorage != 0)
+    {
+        for (uint32_t address = u_pageColourSize; address < u_pageColourSize * 2; address += u_bufferSizeH)
+        {
+            flushStorage->write(address, rowData, u_bufferSizeH);
+        }
+    }
+
+    // Pacing, panel just reset
+    flushStartTime = millis();
+    flushEndTime = flushStartTime;
 
     // Report
     Serial.println(formatString("= Screen %s %ix%i", WhoAmI().c_str(), screenSizeX(), screenSizeY()));
@@ -621,12 +1582,282 @@ void Screen_EPD_EXT3_Fast::begin()
     clear();
 }
 
-String Screen_EPD_EXT3_Fast::WhoAmI()
+bool Screen_EPD_EXT3_Fast::begin(uint8_t * frameBuffer, uint32_t size)
 {
-    char work[64] = {0};
-    u_WhoAmI(work);
+    if ((frameBuffer == 0) or (_panel.codeSizeType == 0x0000))
+    {
+        return false;
+    }
 
-    return formatString("iTC %i.%02i\"%s", _screenDiagonal / 100, _screenDiagonal % 100, work);
+    // Two pages if possible, single page with as many saved rows as possible otherwise
+    uint32_t rowSize = _panel.sizeH / 8;
+    uint32_t pageSize = (uint32_t)_panel.sizeV * rowSize;
+    if (size >= pageSize * 2)
+    {
+        flushSinglePage = false;
+        flushSavedSlots = 0;
+        flushPoolSize = 0;
+    }
+    else if (size >= pageSize + rowSize)
+    {
+        flushPoolSize = size - pageSize - rowSize;
+        uint32_t slots = flushPoolSize / (rowSize + 2);
+        flushSinglePage = true;
+        flushSavedSlots = (slots < _panel.sizeV) ? slots : _panel.sizeV;
+    }
+    else
+    {
+        return false;
+    }
+
+    u_newImage = frameBuffer;
+    begin();
+    return true;
+}
+
+bool Screen_EPD_EXT3_Fast::beginBanded(uint8_t * workBuffer, uint32_t size, uint16_t rows)
+{
+    if ((workBuffer == 0) or (_panel.codeSizeType == 0x0000) or (rows == 0))
+    {
+        return false;
+    }
+
+    // Band buffer, then display list
+    uint32_t bandSize = (uint32_t)rows * (_panel.sizeH / 8);
+    if (size < bandSize + 256)
+    {
+        return false;
+    }
+
+    bandBuffer = workBuffer;
+    bandRows = rows;
+    listData = workBuffer + bandSize;
+    listSize = size - bandSize;
+    begin();
+    return true;
+}
+
+bool Screen_EPD_EXT3_Fast::beginTiled(uint8_t * workBuffer, uint32_t size)
+{
+    if ((workBuffer == 0) or (_panel.codeSizeType == 0x0000))
+    {
+        return false;
+    }
+
+    // Tile map aligned, then tile pool, at least one slot
+    uint16_t tilesByRow = (_panel.sizeH + FLUSH_TILE_SIZE - 1) / FLUSH_TILE_SIZE;
+    uint16_t tilesByColumn = (_panel.sizeV + FLUSH_TILE_SIZE - 1) / FLUSH_TILE_SIZE;
+    uint32_t offset = (alignof(flushTile_s) - ((uintptr_t)workBuffer % alignof(flushTile_s))) % alignof(flushTile_s);
+    uint32_t mapSize = offset + (uint32_t)tilesByRow * tilesByColumn * sizeof(flushTile_s);
+    if (size < mapSize + FLUSH_TILE_BYTES)
+    {
+        return false;
+    }
+
+    uint32_t slots = (size - mapSize) / FLUSH_TILE_BYTES;
+    flushTiled = true;
+    flushTiles = (flushTile_s *)(workBuffer + offset);
+    tilePool = workBuffer + mapSize;
+    tilesH = tilesByRow;
+    tilesV = tilesByColumn;
+    tileSlots = (slots < FLUSH_TILE_UNIFORM) ? slots : FLUSH_TILE_UNIFORM - 1;
+    begin();
+    return true;
+}
+
+bool Screen_EPD_EXT3_Fast::beginStorage(hV_Storage * storage, uint8_t * cacheBuffer, uint32_t size)
+{
+    if ((storage == 0) or (cacheBuffer == 0) or (_panel.codeSizeType == 0x0000))
+    {
+        return false;
+    }
+
+    // Two pages in storage
+    uint32_t rowSize = _panel.sizeH / 8;
+    if (storage->getSize() < (uint32_t)_panel.sizeV * rowSize * 2)
+    {
+        return false;
+    }
+
+    // Lines aligned, then rows, at least two rows for next and previous
+    uint32_t offset = (alignof(flushLine_s) - ((uintptr_t)cacheBuffer % alignof(flushLine_s))) % alignof(flushLine_s);
+    uint32_t lines = (size > offset) ? (size - offset) / (sizeof(flushLine_s) + rowSize) : 0;
+    if (lines < 2)
+    {
+        return false;
+    }
+
+    flushStorage = storage;
+    flushSinglePage = false;
+    rowLineCount = (lines < _panel.sizeV * 2) ? lines : _panel.sizeV * 2;
+    rowLines = (flushLine_s *)(cacheBuffer + offset);
+    rowData = cacheBuffer + offset + rowLineCount * sizeof(flushLine_s);
+    begin();
+    return true;
+}
+
+rowCache_s Screen_EPD_EXT3_Fast::getRowCache()
+{
+    return rowCache;
+}
+
+tilePool_s Screen_EPD_EXT3_Fast::getTilePool()
+{
+    tilePool_s pool;
+    pool.tiles = tilesH * tilesV;
+    pool.slots = tileSlots;
+    pool.used = tileUsed;
+    pool.peak = tilePeak;
+    pool.dropped = tileDropped;
+    pool.peakSize = (uint32_t)pool.tiles * sizeof(flushTile_s) + (uint32_t)tilePeak * FLUSH_TILE_BYTES;
+    pool.denseSize = (uint32_t)_panel.sizeV * (_panel.sizeH / 8) * 2;
+    return pool;
+}
+
+displayList_s Screen_EPD_EXT3_Fast::getDisplayList()
+{
+    displayList_s list;
+    list.size = listSize;
+    list.used = listUsed;
+    list.displayed = listDisplayed;
+    list.dropped = listDropped;
+    list.rasterTime = listRasterTime;
+    return list;
+}
+
+void Screen_EPD_EXT3_Fast::circle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t colour)
+{
+    if ((bandRows == 0) or bandReplaying)
+    {
+        hV_Screen_Buffer::circle(x0, y0, radius, colour);
+        return;
+    }
+
+    uint8_t * output = flush_record(LIST_CIRCLE, 8, (int32_t)x0 - radius, (int32_t)y0 - radius, (int32_t)x0 + radius, (int32_t)y0 + radius);
+    if (output != 0)
+    {
+        uint16_t value[4] = {x0, y0, radius, colour};
+        memcpy(output, value, sizeof(value));
+    }
+}
+
+void Screen_EPD_EXT3_Fast::line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour)
+{
+    if ((bandRows == 0) or bandReplaying)
+    {
+        hV_Screen_Buffer::line(x1, y1, x2, y2, colour);
+        return;
+    }
+
+    uint8_t * output = flush_record(LIST_LINE, 10, x1, y1, x2, y2);
+    if (output != 0)
+    {
+        uint16_t value[5] = {x1, y1, x2, y2, colour};
+        memcpy(output, value, sizeof(value));
+    }
+}
+
+void Screen_EPD_EXT3_Fast::triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t colour)
+{
+    if ((bandRows == 0) or bandReplaying)
+    {
+        hV_Screen_Buffer::triangle(x1, y1, x2, y2, x3, y3, colour);
+        return;
+    }
+
+    uint8_t * output = flush_record(LIST_TRIANGLE, 14, min(x1, min(x2, x3)), min(y1, min(y2, y3)), max(x1, max(x2, x3)), max(y1, max(y2, y3)));
+    if (output != 0)
+    {
+        uint16_t value[7] = {x1, y1, x2, y2, x3, y3, colour};
+        memcpy(output, value, sizeof(value));
+    }
+}
+
+void Screen_EPD_EXT3_Fast::rectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour)
+{
+    if ((bandRows == 0) or bandReplaying)
+    {
+        hV_Screen_Buffer::rectangle(x1, y1, x2, y2, colour);
+        return;
+    }
+
+    uint8_t * output = flush_record(LIST_RECTANGLE, 10, x1, y1, x2, y2);
+    if (output != 0)
+    {
+        uint16_t value[5] = {x1, y1, x2, y2, colour};
+        memcpy(output, value, sizeof(value));
+    }
+}
+
+void Screen_EPD_EXT3_Fast::point(uint16_t x1, uint16_t y1, uint16_t colour)
+{
+    if ((bandRows == 0) or bandReplaying)
+    {
+        hV_Screen_Buffer::point(x1, y1, colour);
+        return;
+    }
+
+    if ((x1 >= screenSizeX()) or (y1 >= screenSizeY()))
+    {
+        return;
+    }
+
+    uint8_t * output = flush_record(LIST_POINT, 6, x1, y1, x1, y1);
+    if (output != 0)
+    {
+        uint16_t value[3] = {x1, y1, colour};
+        memcpy(output, value, sizeof(value));
+    }
+}
+
+void Screen_EPD_EXT3_Fast::gText(uint16_t x0, uint16_t y0,
+                                 String text,
+                                 uint16_t textColour,
+                                 uint16_t backColour)
+{
+    if ((bandRows == 0) or bandReplaying)
+    {
+        hV_Screen_Buffer::gText(x0, y0, text, textColour, backColour);
+        return;
+    }
+
+    uint8_t length = min(text.length(), (unsigned int)255);
+    uint8_t * output = flush_record(LIST_TEXT, 12 + length, x0, y0, (int32_t)x0 + stringSizeX(text), (int32_t)y0 + characterSizeY());
+    if (output != 0)
+    {
+        output[0] = f_fontSize;
+        output[1] = f_fontSpaceX;
+        output[2] = f_fontSpaceY;
+        uint16_t value[4] = {x0, y0, textColour, backColour};
+        memcpy(output + 3, value, sizeof(value));
+        output[11] = length;
+        memcpy(output + 12, text.c_str(), length);
+    }
+}
+
+bool Screen_EPD_EXT3_Fast::setFlushCompression(bool compression)
+{
+    if (not flushSinglePage)
+    {
+        return false;
+    }
+
+    flushCompression = compression;
+    return true;
+}
+
+flushCompression_s Screen_EPD_EXT3_Fast::getFlushCompression()
+{
+    flushCompressionInfo.pageSize = u_pageColourSize;
+    return flushCompressionInfo;
+}
+
+String Screen_EPD_EXT3_Fast::WhoAmI()
+{
+    char work[64] = {0};
+    u_WhoAmI(work);
+
+    return formatString("iTC %i.%02i\"%s", _screenDiagonal / 100, _screenDiagonal % 100, work);
 }
 
 uint8_t Screen_EPD_EXT3_Fast::flushMode(uint8_t updateMode)
@@ -638,7 +1869,7 @@ uint8_t Screen_EPD_EXT3_Fast::flushMode(uint8_t updateMode)
         case UPDATE_FAST:
         case UPDATE_GLOBAL:
 
-            _flushFast();
+            _flush(updateMode);
             break;
 
         default:
@@ -655,293 +1886,2229 @@ void Screen_EPD_EXT3_Fast::flush()
     flushMode(UPDATE_FAST);
 }
 
-void Screen_EPD_EXT3_Fast::_flushFast()
+void Screen_EPD_EXT3_Fast::_flush(uint8_t updateMode)
 {
-    // Configure
-#if FLUSH_TIMING
-    Serial.println("COG_initial");
-    uint32_t t0 = millis();
-#endif
-    COG_initial(UPDATE_FAST);
-#if FLUSH_TIMING
-    uint32_t t1 = millis();
-    char msg[8];
-    itoa(t1 - t0, msg, 10);
-    Serial.println(msg);
-
-    Serial.println("COG_send");
-    t0 = millis();
-#endif
-    // Send image data
-    COG_sendImageDataFast();
-#if FLUSH_TIMING
-    t1 = millis();
-    itoa(t1 - t0, msg, 10);
-    Serial.println(msg);
-
-    Serial.println("COG_update");
-    t0 = millis();
-#endif
-    // Update
-    COG_update(UPDATE_FAST);
-#if FLUSH_TIMING
-    t1 = millis();
-    itoa(t1 - t0, msg, 10);
-    Serial.println(msg);
-
-    Serial.println("COG_off");
-    t0 = millis();
-#endif
-    COG_powerOff();
-#if FLUSH_TIMING
-    t1 = millis();
-    itoa(t1 - t0, msg, 10);
-    Serial.println(msg);
-#endif
+    // Complete the non-blocking update and the maintenance cycle in progress, if any
+    while ((flushState != kReady) or (flushMaintenance > 0))
+    {
+        if (flushState != kReady)
+        {
+            b_waitBusy(nextBusyPinState);
+            flush_resume();
+        }
+        else
+        {
+            delay(1);
+            flush_maintain();
+        }
+    }
+
+    // Rows drawn into layers rebuilt
+    flush_composeLayers();
+
+    // Nothing drawn nor inverted since last upload, image already displayed
+    if ((updateMode == UPDATE_FAST) and (flushDirty == false) and (u_invert == flushInvertPrevious) and (flushPending == false))
+    {
+        return;
+    }
+
+    // This update displays the pending request
+    if (flushPending)
+    {
+        if (flushPendingMode == UPDATE_GLOBAL)
+        {
+            updateMode = UPDATE_GLOBAL;
+        }
+        flushPending = false;
+        flushPendingMode = UPDATE_FAST;
+        flushStatistics.merged++;
+    }
+    flushCurrentDeadline = flushDeadline;
+    flushDeadline = 0;
+
+    // Same sequence as non-blocking update, waiting at each stage
+    flush_start(updateMode);
+    while (flushState != kReady)
+    {
+        b_waitBusy(nextBusyPinState);
+        flush_resume();
+    }
 }
 
-void Screen_EPD_EXT3_Fast::flush_task()
+void Screen_EPD_EXT3_Fast::flush_resume()
 {
-    if (flushState == kReady) return;
-    if (digitalRead(b_pin.panelBusy) != nextBusyPinState) return;
-
+    // Single sequence for blocking and non-blocking update
+    // Each stage ends with the next stage and the busy state to wait for
     switch (flushState)
     {
-        case kCOGInitial_1:
-            // finish COG_Initial _flag152 case
-            // Work settings
-            b_sendCommandData8(0x1a, u_temperature);
-            b_sendCommandData8(0x3c, 0xc0);
-            b_sendCommandData8(0x22, 0xdf);
+        case kCOGInitial:
 
-            flush_sendImageAndStartUpdate();
-            break;
-        case kCOGInitial_2:
-            // finish COG_Initial else
-            b_sendIndexData(0xe5, indexE5_work, 1); // Input Temperature
-            b_sendIndexData(0xe0, indexE0_work, 1); // Activate Temperature
+            COG_initial(flushUpdateMode);
 
-            if (u_codeSize == 0x29) // No PSR
-            {
-                b_sendCommandData8(0x4d, 0x55);
-                b_sendCommandData8(0xe9, 0x02);
-            }
-            else
-            {
-                b_sendIndexData(0x00, index00_work, 2); // PSR
-            }
+            flush_setState(kCOGSend);
+            COG_sendImageDataFast();
+            flushUploaded = true;
 
-            // Specific settings for fast update, all screens
-            if (u_codeExtra & FEATURE_FAST)
-            {
-                uint8_t index50c_work[1]; // Vcom
-                index50c_work[0] = index50c_data[0]; // 0x07
-                b_sendIndexData(0x50, index50c_work, 1); // Vcom and data interval setting
-            }
+            COG_update(flushUpdateMode);
+            flush_wait(kCOGUpdate);
 
-            // Additional settings for fast update, 154 213 266 and 370 screens (_flag50)
-            if ((u_codeExtra & FEATURE_FAST) && _flag50)
+            // Frame-buffer sent, free to modify
+            if (flushUploadedCallback != 0)
             {
-                uint8_t index50a_work[1]; // Vcom
-                index50a_work[0] = index50a_data[0]; // 0x27
-                b_sendIndexData(0x50, index50a_work, 1); // Vcom and data interval setting
+                flushUploadedCallback();
             }
-
-            flush_sendImageAndStartUpdate();
-            break;
-        case kCOGUpdate_1:
-            b_sendCommand8(0x20); // Display Refresh
-            digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
-            nextBusyPinState = LOW;
-            flushState = kCOGPowerOff_1;
             break;
-        case kCOGUpdate_2:
-            b_sendCommand8(0x12); // Display Refresh
-            digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
-            nextBusyPinState = HIGH;
-            flushState = kCOGPowerOff_1;
+
+        case kCOGUpdate:
+
+            COG_refresh();
+            flush_wait(kCOGRefresh);
             break;
-        case kCOGPowerOff_1:
-            if (_flag152 == true)
+
+        case kCOGRefresh:
+
+            // Refresh completed, new image visible
+            flush_visible();
+
+            if (_panel.flag152 == true)
             {
-                flushState = kReady;
+                flush_complete();
             }
             else
             {
-                b_sendCommand8(0x02); // Turn off DC/DC
-                digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
-                nextBusyPinState = HIGH;
-                flushState = kCOGPowerOff_2;
+                COG_powerOff();
+                flush_wait(kCOGPowerOff);
+            }
+
+            if (flushVisibleCallback != 0)
+            {
+                flushVisibleCallback();
             }
             break;
-        case kCOGPowerOff_2:
-            flushState = kReady;
+
+        case kCOGPowerOff:
+
+            flush_complete();
             break;
+
         default:
+
             break;
     }
+}
+
+void Screen_EPD_EXT3_Fast::flush_task()
+{
+    if (flushState != kReady)
+    {
+        if (digitalRead(b_pin.panelBusy) != nextBusyPinState)
+        {
+            return;
+        }
+
+        flush_resume();
+    }
 
-    if ((flushState == kReady) && flushPending)
+    if ((flushState == kReady) and flushPending)
     {
-        // start a new flush cycle
-        flush_nonBlocking();
-        flushPending = false;
+        // start a new flush cycle, if allowed by the pacing policy
+        flush_schedule();
     }
-}
 
-void Screen_EPD_EXT3_Fast::flush_sendImageAndStartUpdate()
-{
-    COG_sendImageDataFast();
+    if (flushRegenerate > 0)
+    {
+        flush_regenerate();
+    }
 
-    // start COG_Update
-    if (_flag152 == true)
+    if ((flushGhostingThreshold > 0) or (flushMaintenance > 0))
     {
-        nextBusyPinState = LOW;
-        flushState = kCOGUpdate_1;
+        flush_maintain();
     }
-    else
+
+#if defined(__cpp_impl_coroutine)
+    // Resume the coroutines whose update is completed
+    for (uint8_t index = 0; index < FLUSH_AWAITERS; index++)
     {
-        // Specific settings for fast update, 154 213 266 and 370 screens (_flag50)
-        if ((u_codeExtra & FEATURE_FAST) && _flag50)
+        if (flushAwaiting[index] and ((int32_t)(flushCompleted - flushAwaitingSequence[index]) >= 0))
         {
-            index50b_work[0] = index50b_data[0]; // 0x07
-            b_sendIndexData(0x50, index50b_work, 1); // Vcom and data interval setting
+            std::coroutine_handle<> handle = flushAwaiting[index];
+            flushAwaiting[index] = nullptr;
+            handle.resume();
         }
+    }
+#endif // __cpp_impl_coroutine
+}
 
-        b_sendCommand8(0x04); // Power on
-        digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
-        nextBusyPinState = HIGH;
-        flushState = kCOGUpdate_2;
+void Screen_EPD_EXT3_Fast::flush_visible()
+{
+    flushVisibleTimestamp = micros();
+    flushVisibleTime = millis();
+    flushLatency = flushVisibleTime - flushStartTime;
+
+    // Deadline means visible by
+    if ((flushCurrentDeadline > 0) and ((int32_t)(flushVisibleTime - flushCurrentDeadline) > 0))
+    {
+        flushStatistics.late++;
     }
+    flushCurrentDeadline = 0;
 }
 
-void Screen_EPD_EXT3_Fast::flush_nonBlocking()
+void Screen_EPD_EXT3_Fast::flush_nonBlocking(uint32_t deadline)
 {
-    if (flushState != kReady)
+    flushMode_nonBlocking(UPDATE_FAST, deadline);
+}
+
+void Screen_EPD_EXT3_Fast::flushMode_nonBlocking(uint8_t updateMode, uint32_t deadline)
+{
+    flushStatistics.requested++;
+
+    if (u_newImage == 0) // begin() not yet called
     {
-        flushPending = true;
+        flushStatistics.dropped++;
+        return;
+    }
+
+    // Rows drawn into layers rebuilt
+    flush_composeLayers();
+
+    // Nothing drawn nor inverted since last upload, image already displayed or uploaded
+    if ((updateMode == UPDATE_FAST) and (flushDirty == false) and (u_invert == flushInvertPrevious) and (flushPending == false))
+    {
+        flushStatistics.merged++;
         return;
     }
 
-    if (_flag152 == true)
+    if (flushState != kReady)
     {
-        // Soft reset
-        b_sendCommand8(0x12);
-        digitalWrite(b_pin.panelDC, LOW); // Select
-        nextBusyPinState = LOW;
-        flushState = kCOGInitial_1;
+        if ((flushUploaded == false) and (flushMaintenance == 0))
+        {
+            // Frame-buffer not yet sent, the update in progress takes this request
+            // Settings not yet sent, global update prevails
+            flushStatistics.merged++;
+            if ((updateMode == UPDATE_GLOBAL) and (checkTemperatureMode(UPDATE_GLOBAL) == UPDATE_GLOBAL))
+            {
+                flushUpdateMode = UPDATE_GLOBAL;
+            }
+            if ((deadline > 0) and ((flushCurrentDeadline == 0) or ((int32_t)(deadline - flushCurrentDeadline) < 0)))
+            {
+                flushCurrentDeadline = deadline;
+            }
+            return;
+        }
+    }
+
+    // Default latency for requests without deadline, from the time of the request
+    uint32_t target = deadline;
+    if (deadline == 0)
+    {
+        target = millis() + flushInterval;
+    }
+
+    if (flushPending)
+    {
+        // Joins the pending update
+        flushStatistics.merged++;
+        if ((int32_t)(target - flushTarget) < 0)
+        {
+            flushTarget = target;
+        }
     }
     else
     {
-        indexE0_work[0] = indexE0_data[0];
-        indexE5_data[0] = u_temperature;
-        if (u_codeExtra & FEATURE_FAST) // Specific settings for fast update
+        flushPending = true;
+        flushTarget = target;
+    }
+
+    // Global update prevails
+    if (updateMode == UPDATE_GLOBAL)
+    {
+        flushPendingMode = UPDATE_GLOBAL;
+    }
+
+    // Keep the earliest deadline
+    if ((deadline > 0) and ((flushDeadline == 0) or ((int32_t)(deadline - flushDeadline) < 0)))
+    {
+        flushDeadline = deadline;
+    }
+
+    if (flushState == kReady)
+    {
+        flush_schedule();
+    }
+}
+
+uint32_t Screen_EPD_EXT3_Fast::flush_target()
+{
+    // Update displaying the last request
+    if (flushPending)
+    {
+        if (flushMaintenance > 0)
         {
-            indexE5_work[0] = indexE5_data[0] | 0x40; // temperature | 0x40
-            index00_work[0] = index00_data[0] | 0x10; // PSR0 | 0x10
-            index00_work[1] = index00_data[1] | 0x02; // PSR1 | 0x02
+            return flushSequence + (3 - flushMaintenance) + 1; // After the remaining maintenance phases
         }
-        else // Common settings
+        return flushSequence + 1; // Next update
+    }
+    else if (flushState != kReady)
+    {
+        return flushSequence; // Update in progress, not yet uploaded
+    }
+    return flushCompleted; // Nothing to wait for
+}
+
+#if defined(__cpp_impl_coroutine)
+Screen_EPD_EXT3_Fast::flushAwaiter Screen_EPD_EXT3_Fast::flush_await(uint32_t deadline)
+{
+    flush_nonBlocking(deadline);
+
+    flushAwaiter awaiter;
+    awaiter.screen = this;
+    awaiter.sequence = flush_target();
+    return awaiter;
+}
+
+bool Screen_EPD_EXT3_Fast::flush_suspend(std::coroutine_handle<> handle, uint32_t sequence)
+{
+    for (uint8_t index = 0; index < FLUSH_AWAITERS; index++)
+    {
+        if (not flushAwaiting[index])
+        {
+            flushAwaiting[index] = handle;
+            flushAwaitingSequence[index] = sequence;
+            return true;
+        }
+    }
+    return false; // Full, not suspended
+}
+#endif // __cpp_impl_coroutine
+
+void Screen_EPD_EXT3_Fast::flush_schedule()
+{
+    if (flushMaintenance > 0)
+    {
+        return; // held until the maintenance cycle is completed
+    }
+
+    uint32_t chrono = millis();
+    uint32_t start = chrono; // earliest start allowed
+
+    switch (flushPolicy)
+    {
+        case FLUSH_POLICY_RATE:
+
+            start = flushStartTime + flushInterval;
+            break;
+
+        case FLUSH_POLICY_DEADLINE:
+
+            // As late as possible, based on the time from start to visible of the previous update
+            // Immediately if not yet measured
+            if (flushLatency > 0)
+            {
+                start = flushTarget - flushLatency;
+            }
+            break;
+
+        default: // FLUSH_POLICY_LATEST
+
+            start = flushEndTime + flushInterval;
+            break;
+    }
+
+    if ((int32_t)(chrono - start) < 0)
+    {
+        return; // held, flush_task() checks again
+    }
+
+    flushPending = false;
+    flushCurrentDeadline = flushDeadline;
+    flushDeadline = 0;
+
+    // Same check as blocking update
+    uint8_t updateMode = checkTemperatureMode(flushPendingMode);
+    flushPendingMode = UPDATE_FAST;
+    if (updateMode == UPDATE_NONE)
+    {
+        Serial.println("* PDLS - UPDATE_NONE invoked");
+        flushStatistics.dropped++;
+        flushCurrentDeadline = 0;
+
+        // Settle the awaiting coroutines
+        flushSequence++;
+        flushCompleted = flushSequence;
+        return;
+    }
+
+    flushStatistics.started++;
+    flush_start(updateMode);
+}
+
+void Screen_EPD_EXT3_Fast::setFlushPolicy(uint8_t policy, uint32_t interval)
+{
+    flushPolicy = policy;
+    flushInterval = interval;
+}
+
+flushStatistics_s Screen_EPD_EXT3_Fast::getFlushStatistics()
+{
+    return flushStatistics;
+}
+
+void Screen_EPD_EXT3_Fast::resetFlushStatistics()
+{
+    memset(&flushStatistics, 0x00, sizeof(flushStatistics));
+}
+
+Screen_EPD_EXT3_Fast::FlushState Screen_EPD_EXT3_Fast::getFlushState()
+{
+    return flushState;
+}
+
+bool Screen_EPD_EXT3_Fast::isBusy()
+{
+    return ((flushState != kReady) or flushPending or (flushRegenerate > 0) or (flushMaintenance > 0));
+}
+
+uint32_t Screen_EPD_EXT3_Fast::getFlushDuration()
+{
+    return flushDuration;
+}
+
+uint32_t Screen_EPD_EXT3_Fast::getFlushTimestamp(FlushState state)
+{
+    if (state > kCOGPowerOff)
+    {
+        return 0;
+    }
+    return flushTimestamps[state];
+}
+
+uint32_t Screen_EPD_EXT3_Fast::getFlushVisibleTimestamp()
+{
+    return flushVisibleTimestamp;
+}
+
+void Screen_EPD_EXT3_Fast::setFlushCallbacks(flushCallback_t uploaded, flushCallback_t visible)
+{
+    flushUploadedCallback = uploaded;
+    flushVisibleCallback = visible;
+}
+
+void Screen_EPD_EXT3_Fast::flush_setState(FlushState state)
+{
+    flushState = state;
+    flushTimestamps[state] = micros();
+}
+
+void Screen_EPD_EXT3_Fast::flush_wait(FlushState state)
+{
+    flush_setState(state);
+
+    // 150 and 152 specific, busy until LOW
+    nextBusyPinState = (_panel.flag152 ? LOW : HIGH);
+}
+
+void Screen_EPD_EXT3_Fast::flush_start(uint8_t updateMode)
+{
+    flushUpdateMode = updateMode;
+    flushBand = flush_band();
+    flushSequence++;
+    flushStartTime = millis();
+    flushUploaded = false;
+
+    COG_reset();
+    flush_wait(kCOGInitial);
+}
+
+void Screen_EPD_EXT3_Fast::flush_complete()
+{
+    flush_setState(kReady);
+    flushCompleted = flushSequence;
+
+    flushEndTime = millis();
+    flushDuration = flushEndTime - flushStartTime;
+
+    // Metrics, 152 without power-off
+    uint8_t mode = (flushUpdateMode == UPDATE_GLOBAL) ? 0 : 1;
+    flush_measure(flushMetrics[FLUSH_STAGE_INITIAL][mode][flushBand], flushTimestamps[kCOGSend] - flushTimestamps[kCOGInitial]);
+    flush_measure(flushMetrics[FLUSH_STAGE_SEND][mode][flushBand], flushTimestamps[kCOGUpdate] - flushTimestamps[kCOGSend]);
+    flush_measure(flushMetrics[FLUSH_STAGE_UPDATE][mode][flushBand], flushVisibleTimestamp - flushTimestamps[kCOGUpdate]);
+    flush_measure(flushMetrics[FLUSH_STAGE_POWEROFF][mode][flushBand], flushTimestamps[kReady] - flushVisibleTimestamp);
+}
+
+void Screen_EPD_EXT3_Fast::flush_measure(flushMetrics_s & metrics, uint32_t duration)
+{
+    if ((metrics.count == 0) or (duration < metrics.minimum))
+    {
+        metrics.minimum = duration;
+    }
+    if (duration > metrics.maximum)
+    {
+        metrics.maximum = duration;
+    }
+    metrics.count++;
+    metrics.total += duration;
+
+    // Bucket n for [2^n, 2^(n+1)[ µs, last bucket for longer durations
+    uint8_t bucket = (duration > 1) ? (31 - __builtin_clz(duration)) : 0;
+    if (bucket >= FLUSH_BUCKETS)
+    {
+        bucket = FLUSH_BUCKETS - 1;
+    }
+    if (metrics.histogram[bucket] < UINT16_MAX)
+    {
+        metrics.histogram[bucket]++;
+    }
+}
+
+flushMetrics_s Screen_EPD_EXT3_Fast::getFlushMetrics(uint8_t stage, uint8_t updateMode, uint8_t band)
+{
+    flushMetrics_s metrics;
+    memset(&metrics, 0x00, sizeof(metrics));
+
+    if ((stage < FLUSH_STAGES) and ((updateMode == UPDATE_GLOBAL) or (updateMode == UPDATE_FAST)) and (band < FLUSH_BANDS))
+    {
+        metrics = flushMetrics[stage][(updateMode == UPDATE_GLOBAL) ? 0 : 1][band];
+    }
+    return metrics;
+}
+
+void Screen_EPD_EXT3_Fast::resetFlushMetrics()
+{
+    memset(flushMetrics, 0x00, sizeof(flushMetrics));
+}
+
+uint8_t Screen_EPD_EXT3_Fast::flush_band()
+{
+    return (u_temperature < 15) ? FLUSH_BAND_COLD : ((u_temperature > 30) ? FLUSH_BAND_HOT : FLUSH_BAND_NOMINAL);
+}
+
+uint8_t Screen_EPD_EXT3_Fast::getFlushPredictedMode(uint8_t updateMode)
+{
+    return checkTemperatureMode(updateMode);
+}
+
+uint32_t Screen_EPD_EXT3_Fast::getFlushPredictedCost(uint8_t updateMode)
+{
+    updateMode = checkTemperatureMode(updateMode);
+    if (updateMode == UPDATE_NONE)
+    {
+        return 0;
+    }
+
+    // Sum of the mean durations until visible
+    uint8_t mode = (updateMode == UPDATE_GLOBAL) ? 0 : 1;
+    uint8_t band = flush_band();
+    uint64_t cost = 0; // µs
+    for (uint8_t stage = FLUSH_STAGE_INITIAL; stage <= FLUSH_STAGE_UPDATE; stage++)
+    {
+        const flushMetrics_s & metrics = flushMetrics[stage][mode][band];
+        if (metrics.count == 0)
+        {
+            return 0;
+        }
+        cost += metrics.total / metrics.count;
+    }
+    return (uint32_t)(cost / 1000);
+}
+
+void Screen_EPD_EXT3_Fast::clear(uint16_t colour)
+{
+    if (layerTarget != 0)
+    {
+        // Layer selected, one memset
+        if (colour == myColours.grey)
+        {
+            // Same pattern for rows and transposed columns
+            for (uint16_t row = 0; row < layerTarget->rows; row++)
+            {
+                memset(layerTarget->data + (uint32_t)row * layerTarget->rowSize, (row % 2) ? 0b10101010 : 0b01010101, layerTarget->rowSize);
+            }
+        }
+        else
+        {
+            memset(layerTarget->data, (colour == myColours.white) ? 0x00 : 0xff, (uint32_t)layerTarget->rows * layerTarget->rowSize);
+        }
+        layerFirst = 0;
+        layerLast = u_bufferSizeV - 1;
+        return;
+    }
+
+    if (bandRows > 0)
+    {
+        // New display list, after the displayed frame if needed
+        if (listStart < listDisplayed)
+        {
+            listStart = listUsed;
+        }
+        else
+        {
+            listUsed = listStart;
+        }
+        uint8_t * output = flush_record(LIST_CLEAR, 2, 0, 0, screenSizeX() - 1, screenSizeY() - 1);
+        if (output != 0)
+        {
+            memcpy(output, &colour, sizeof(colour));
+        }
+        return;
+    }
+
+    if (flushTiled)
+    {
+        // Uniform tiles, or materialised for grey
+        for (uint16_t index = 0; index < tilesH * tilesV; index++)
+        {
+            if (colour != myColours.grey)
+            {
+                flush_setTile(index, (colour == myColours.white) ? 0x00 : 0xff);
+                continue;
+            }
+
+            uint8_t * data = flush_touchTile(index);
+            if (data != 0)
+            {
+                for (uint16_t row = 0; row < FLUSH_TILE_SIZE; row++)
+                {
+                    memset(data + row * (FLUSH_TILE_SIZE / 8), (row % 2) ? 0b10101010 : 0b01010101, FLUSH_TILE_SIZE / 8);
+                }
+            }
+        }
+        flushDirty = true;
+        return;
+    }
+
+    for (uint16_t row = 0; row < u_bufferSizeV; row++)
+    {
+        // Whole row written, no copy from previous
+        flush_touchRow(row, true);
+        flushRows[row].flags |= FLUSH_ROW_DIRTY;
+        _clearRow(flush_row(row, 0, FLUSH_ACCESS_WHOLE), row, colour);
+    }
+    flushDirty = true;
+}
+
+void Screen_EPD_EXT3_Fast::_clearRow(uint8_t * data, uint16_t row, uint16_t colour)
+{
+    if (colour == myColours.grey)
+    {
+        uint16_t pattern = (row % 2) ? 0b10101010 : 0b01010101;
+        memset(data, pattern, u_bufferSizeH);
+    }
+    else if (colour == myColours.white)
+    {
+        // physical black 00
+        memset(data, 0x00, u_bufferSizeH);
+    }
+    else
+    {
+        // physical white 10
+        memset(data, 0xff, u_bufferSizeH);
+    }
+}
+
+bool Screen_EPD_EXT3_Fast::scroll(int16_t dx, int16_t dy, uint16_t fill)
+{
+    // Display list and tiles not addressed as rows
+    if ((bandRows > 0) or flushTiled)
+    {
+        return false;
+    }
+
+    // Physical shift, rows and columns of the frame-buffer, see _orientPoint()
+    int16_t shiftRow;
+    int16_t shiftColumn;
+    switch (_orientation)
+    {
+        case 3:
+
+            shiftRow = -dx;
+            shiftColumn = dy;
+            break;
+
+        case 2:
+
+            shiftRow = -dy;
+            shiftColumn = -dx;
+            break;
+
+        case 1:
+
+            shiftRow = dx;
+            shiftColumn = -dy;
+            break;
+
+        default:
+
+            shiftRow = dy;
+            shiftColumn = dx;
+            break;
+    }
+
+    if ((shiftRow == 0) and (shiftColumn == 0))
+    {
+        return true;
+    }
+    bool beyond = (abs(shiftColumn) >= u_bufferSizeH * 8);
+
+    if (fill != pointColour)
+    {
+        _resolveColour(fill);
+    }
+
+    // Rows in the direction of the shift, source row read before written
+    for (uint16_t index = 0; index < u_bufferSizeV; index++)
+    {
+        uint16_t row = (shiftRow > 0) ? u_bufferSizeV - 1 - index : index;
+        int32_t source = (int32_t)row - shiftRow;
+
+        flushRow_s & meta = flushRows[row];
+        if (meta.flags & FLUSH_ROW_STALE)
+        {
+            flush_touchRow(row, (shiftRow != 0) or beyond);
+        }
+
+        uint8_t * data;
+        if ((source < 0) or (source >= u_bufferSizeV) or beyond)
+        {
+            // Row uncovered, grey with the same pattern as the uncovered columns
+            data = flush_row(row, 0, FLUSH_ACCESS_WHOLE);
+            _clearRow(data, row, fill);
+            _fillBytes(data, row, 0, u_bufferSizeH * 8 - 1);
+        }
+        else
+        {
+            if (shiftRow != 0)
+            {
+                // Row moved, whole bytes
+                const uint8_t * previous = flush_row(source, 0);
+                data = flush_row(row, 0, FLUSH_ACCESS_WHOLE);
+                memcpy(data, previous, u_bufferSizeH);
+            }
+            else
+            {
+                data = flush_row(row, 0, FLUSH_ACCESS_WRITE);
+            }
+
+            if (shiftColumn != 0)
+            {
+                _shiftRow(data, row, shiftColumn);
+            }
+        }
+
+        meta.flags |= FLUSH_ROW_DIRTY;
+    }
+    flushDirty = true;
+    return true;
+}
+
+void Screen_EPD_EXT3_Fast::_shiftRow(uint8_t * data, uint16_t row, int16_t shift)
+{
+    // Whole bytes moved, then bits for a shift not multiple of 8
+    uint16_t bytes = abs(shift) >> 3;
+    uint8_t bits = abs(shift) & 0x07;
+    uint16_t columns = u_bufferSizeH * 8;
+
+    if (shift > 0)
+    {
+        // Towards last column, 0x01 of byte n into 0x80 of byte n + 1
+        memmove(data + bytes, data, u_bufferSizeH - bytes);
+        if (bits > 0)
+        {
+            for (uint16_t index = u_bufferSizeH - 1; index > bytes; index--)
+            {
+                data[index] = (data[index] >> bits) | (data[index - 1] << (8 - bits));
+            }
+            data[bytes] >>= bits;
+        }
+        _fillBytes(data, row, 0, shift - 1);
+    }
+    else
+    {
+        // Towards first column, 0x80 of byte n + 1 into 0x01 of byte n
+        uint16_t last = u_bufferSizeH - bytes - 1;
+        memmove(data, data + bytes, u_bufferSizeH - bytes);
+        if (bits > 0)
+        {
+            for (uint16_t index = 0; index < last; index++)
+            {
+                data[index] = (data[index] << bits) | (data[index + 1] >> (8 - bits));
+            }
+            data[last] <<= bits;
+        }
+        _fillBytes(data, row, columns + shift, columns - 1);
+    }
+}
+
+bool Screen_EPD_EXT3_Fast::setSurfaceArena(uint8_t * arena, uint32_t size)
+{
+    // Arena aligned for the first descriptor
+    uint32_t offset = (alignof(surface_s) - ((uintptr_t)arena % alignof(surface_s))) % alignof(surface_s);
+    if ((arena == 0) or (size < offset + sizeof(surface_s)))
+    {
+        return false;
+    }
+
+    surfaceArena = arena + offset;
+    surfaceArenaSize = size - offset;
+    surfaceUsed = 0;
+    surfacePeak = 0;
+
+    // Layers on previous surfaces removed
+    for (uint8_t index = 0; index < FLUSH_LAYERS; index++)
+    {
+        flushLayers[index] = {0, 0, LAYER_NONE};
+    }
+    if (layerTarget != 0)
+    {
+        layerTarget = 0;
+        _setOrientation(_orientation);
+    }
+    return true;
+}
+
+surface_s * Screen_EPD_EXT3_Fast::newSurface(uint16_t sizeX, uint16_t sizeY, uint8_t layout)
+{
+    if ((surfaceArena == 0) or (sizeX == 0) or (sizeY == 0) or (layout > SURFACE_LAYOUT_ROWS))
+    {
+        return 0; // nullptr
+    }
+
+    // Physical rows and columns, see _orientPoint(), swapped if transposed
+    bool transposed = (layout == SURFACE_LAYOUT_TRANSPOSED) or ((layout == SURFACE_LAYOUT_ROWS) and (_orientation % 2));
+    uint16_t rows = ((_orientation % 2) != transposed) ? sizeX : sizeY;
+    uint16_t columns = ((_orientation % 2) != transposed) ? sizeY : sizeX;
+    uint16_t rowSize = (columns + 7) / 8;
+
+    // Descriptor aligned, then rows
+    uintptr_t address = (uintptr_t)(surfaceArena + surfaceUsed);
+    uint32_t offset = surfaceUsed + (alignof(surface_s) - address % alignof(surface_s)) % alignof(surface_s);
+    uint32_t size = sizeof(surface_s) + (uint32_t)rows * rowSize;
+    if (offset + size > surfaceArenaSize)
+    {
+        return 0; // nullptr
+    }
+
+    surface_s * surface = (surface_s *)(surfaceArena + offset);
+    surface->data = surfaceArena + offset + sizeof(surface_s);
+    surface->rows = rows;
+    surface->columns = columns;
+    surface->rowSize = rowSize;
+    surface->transposed = transposed;
+    surface->row = 0;
+    surface->column = 0;
+    memset(surface->data, 0x00, (uint32_t)rows * rowSize);
+
+    surfaceUsed = offset + size;
+    surfacePeak = max(surfacePeak, surfaceUsed);
+    return surface;
+}
+
+void Screen_EPD_EXT3_Fast::releaseSurface(surface_s * surface)
+{
+    // Surface and all surfaces allocated after it
+    if (((uint8_t *)surface < surfaceArena) or ((uint8_t *)surface >= surfaceArena + surfaceUsed))
+    {
+        return;
+    }
+    surfaceUsed = (uint8_t *)surface - surfaceArena;
+
+    // Layers on released surfaces removed
+    for (uint8_t index = 0; index < FLUSH_LAYERS; index++)
+    {
+        flushLayer_s & layer = flushLayers[index];
+        if ((layer.surface >= surface) or (layer.mask >= surface))
+        {
+            setLayer(index, 0);
+        }
+    }
+    if (layerTarget >= surface)
+    {
+        selectLayer(LAYER_SCREEN);
+    }
+}
+
+surfaceArena_s Screen_EPD_EXT3_Fast::getSurfaceArena()
+{
+    surfaceArena_s result = {surfaceArenaSize, surfaceUsed, surfacePeak};
+    return result;
+}
+
+bool Screen_EPD_EXT3_Fast::copyRect(surface_s * target, uint16_t x, uint16_t y, surface_s * source, uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy)
+{
+    if ((target == source) or (dx == 0) or (dy == 0))
+    {
+        return false;
+    }
+
+    // Transposed surfaces drawn as layers only
+    if (((target != 0) and target->transposed) or ((source != 0) and source->transposed))
+    {
+        return false;
+    }
+
+    // Display list and tiles not addressed as rows
+    if (((target == 0) or (source == 0)) and ((bandRows > 0) or flushTiled))
+    {
+        return false;
+    }
+
+    // Physical rectangles, same orientation for source and target
+    if ((_orientRect(x0, y0, dx, dy, (source == 0) ? u_bufferSizeV : source->rows, (source == 0) ? u_bufferSizeH * 8 : source->columns) == RESULT_ERROR) or
+            (_orientRect(x, y, dx, dy, (target == 0) ? u_bufferSizeV : target->rows, (target == 0) ? u_bufferSizeH * 8 : target->columns) == RESULT_ERROR))
+    {
+        return false;
+    }
+
+    _copyRows(target, x, y, source, x0, y0, (_orientation % 2) ? dx : dy, (_orientation % 2) ? dy : dx);
+    return true;
+}
+
+surface_s * Screen_EPD_EXT3_Fast::saveRect(uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy)
+{
+    if ((bandRows > 0) or flushTiled or (dx == 0) or (dy == 0))
+    {
+        return 0; // nullptr
+    }
+
+    uint16_t row = x0;
+    uint16_t column = y0;
+    if (_orientRect(row, column, dx, dy, u_bufferSizeV, u_bufferSizeH * 8) == RESULT_ERROR)
+    {
+        return 0; // nullptr
+    }
+
+    surface_s * surface = newSurface(dx, dy);
+    if (surface != 0)
+    {
+        // Position kept as physical, restored regardless of the orientation
+        _copyRows(surface, 0, 0, 0, row, column, surface->rows, surface->columns);
+        surface->row = row;
+        surface->column = column;
+    }
+    return surface;
+}
+
+bool Screen_EPD_EXT3_Fast::restoreRect(surface_s * surface)
+{
+    if ((surface == 0) or surface->transposed or (bandRows > 0) or flushTiled)
+    {
+        return false;
+    }
+
+    _copyRows(0, surface->row, surface->column, surface, 0, 0, surface->rows, surface->columns);
+    return true;
+}
+
+bool Screen_EPD_EXT3_Fast::_orientRect(uint16_t & x, uint16_t & y, uint16_t dx, uint16_t dy, uint16_t rows, uint16_t columns)
+{
+    // Logical sizes, x-axis along the rows for orientations 1 and 3
+    uint16_t sizeX = (_orientation % 2) ? rows : columns;
+    uint16_t sizeY = (_orientation % 2) ? columns : rows;
+    if (((uint32_t)x + dx > sizeX) or ((uint32_t)y + dy > sizeY))
+    {
+        return RESULT_ERROR;
+    }
+
+    // First physical row and column, see _orientPoint()
+    switch (_orientation)
+    {
+        case 3:
+
+            x = rows - x - dx;
+            break;
+
+        case 2:
+
+            x = columns - x - dx;
+            y = rows - y - dy;
+            swap(x, y);
+            break;
+
+        case 1:
+
+            y = columns - y - dy;
+            break;
+
+        default:
+
+            swap(x, y);
+            break;
+    }
+    return RESULT_SUCCESS;
+}
+
+void Screen_EPD_EXT3_Fast::_copyRows(surface_s * target, uint16_t row, uint16_t column, surface_s * source, uint16_t sourceRow, uint16_t sourceColumn, uint16_t rows, uint16_t columns)
+{
+    for (uint16_t index = 0; index < rows; index++)
+    {
+        // Target row of the screen prepared first, source row used right after
+        uint8_t access = FLUSH_ACCESS_WRITE;
+        if (target == 0)
+        {
+            flushRow_s & meta = flushRows[row + index];
+            bool whole = (column == 0) and (columns == u_bufferSizeH * 8);
+            if (meta.flags & FLUSH_ROW_STALE)
+            {
+                flush_touchRow(row + index, whole);
+            }
+            meta.flags |= FLUSH_ROW_DIRTY;
+            access = whole ? FLUSH_ACCESS_WHOLE : FLUSH_ACCESS_WRITE;
+        }
+
+        const uint8_t * from = (source == 0) ? flush_row(sourceRow + index, 0) : source->data + (uint32_t)(sourceRow + index) * source->rowSize;
+        uint8_t * to = (target == 0) ? flush_row(row + index, 0, access) : target->data + (uint32_t)(row + index) * target->rowSize;
+        _copyBits(to, column, from, sourceColumn, columns);
+    }
+
+    if (target == 0)
+    {
+        flushDirty = true;
+    }
+    else
+    {
+        // Surface possibly used as a layer
+        layerFirst = min(layerFirst, row);
+        layerLast = max(layerLast, (uint16_t)(row + rows - 1));
+    }
+}
+
+bool Screen_EPD_EXT3_Fast::setLayer(uint8_t layer, surface_s * surface, uint8_t operation, surface_s * mask)
+{
+    if ((layer >= FLUSH_LAYERS) or (bandRows > 0) or flushTiled)
+    {
+        return false;
+    }
+
+    if ((surface == 0) or (operation == LAYER_NONE))
+    {
+        // Layer removed, frame-buffer no longer drawn into it
+        if ((layerTarget != 0) and (layerTarget == flushLayers[layer].surface))
+        {
+            selectLayer(LAYER_SCREEN);
+        }
+        flushLayers[layer] = {0, 0, LAYER_NONE};
+    }
+    else
+    {
+        // Full screen surfaces, rows and columns swapped if transposed
+        uint16_t rows = surface->transposed ? u_bufferSizeH * 8 : u_bufferSizeV;
+        uint16_t columns = surface->transposed ? u_bufferSizeV : u_bufferSizeH * 8;
+        if ((surface->rows != rows) or (surface->columns != columns) or (operation > LAYER_XOR))
+        {
+            return false;
+        }
+        if ((mask != 0) and ((mask->transposed != surface->transposed) or (mask->rows != rows) or (mask->columns != columns)))
+        {
+            return false;
+        }
+
+        // Transposed surfaces composited 8 rows at a time, one row cached in storage mode
+        if (surface->transposed and (flushStorage != 0))
+        {
+            return false;
+        }
+        flushLayers[layer] = {surface, mask, operation};
+    }
+
+    // All rows rebuilt at next flush
+    layerFirst = 0;
+    layerLast = u_bufferSizeV - 1;
+    return true;
+}
+
+bool Screen_EPD_EXT3_Fast::selectLayer(uint8_t layer)
+{
+    if (layer == LAYER_SCREEN)
+    {
+        layerTarget = 0; // nullptr
+    }
+    else if ((layer < FLUSH_LAYERS) and (flushLayers[layer].surface != 0))
+    {
+        layerTarget = flushLayers[layer].surface;
+    }
+    else
+    {
+        return false;
+    }
+
+    // Writer for the layer or the frame-buffer
+    _setOrientation(_orientation);
+    return true;
+}
+
+void Screen_EPD_EXT3_Fast::flush_composeLayers()
+{
+    // Nothing drawn into surfaces since last composition
+    if (layerFirst > layerLast)
+    {
+        return;
+    }
+
+    bool active = false;
+    for (uint8_t index = 0; index < FLUSH_LAYERS; index++)
+    {
+        active = active or (flushLayers[index].surface != 0);
+    }
+
+    // Groups of 8 rows for the 8x8 blocks of transposed layers, one row in storage mode
+    uint8_t group = (flushStorage != 0) ? 1 : 8;
+    for (uint16_t first = layerFirst - layerFirst % group; active and (first <= layerLast); first += group)
+    {
+        // Whole rows rebuilt from white, layers in increasing order
+        uint8_t count = min((uint16_t)group, (uint16_t)(u_bufferSizeV - first));
+        uint8_t * rows[8];
+        for (uint8_t index = 0; index < count; index++)
+        {
+            flushRow_s & meta = flushRows[first + index];
+            if (meta.flags & FLUSH_ROW_STALE)
+            {
+                flush_touchRow(first + index, true);
+            }
+            rows[index] = flush_row(first + index, 0, FLUSH_ACCESS_WHOLE);
+            memset(rows[index], 0x00, u_bufferSizeH);
+            meta.flags |= FLUSH_ROW_DIRTY;
+        }
+
+        for (uint8_t index = 0; index < FLUSH_LAYERS; index++)
+        {
+            const flushLayer_s & layer = flushLayers[index];
+            if (layer.surface == 0)
+            {
+                continue;
+            }
+
+            switch (layer.operation)
+            {
+                case LAYER_OR:
+
+                    flush_blendRows<LAYER_OR>(rows, count, first, layer);
+                    break;
+
+                case LAYER_AND:
+
+                    flush_blendRows<LAYER_AND>(rows, count, first, layer);
+                    break;
+
+                case LAYER_XOR:
+
+                    flush_blendRows<LAYER_XOR>(rows, count, first, layer);
+                    break;
+
+                default: // LAYER_REPLACE
+
+                    flush_blendRows<LAYER_REPLACE>(rows, count, first, layer);
+                    break;
+            }
+        }
+
+        flushDirty = true;
+    }
+
+    layerFirst = 0xffff;
+    layerLast = 0;
+}
+
+///
+/// @brief Blend a layer, with the mask applied
+/// @param value layers below
+/// @param source layer
+/// @param select mask, bits set where the layer applies
+/// @return layers below and layer
+///
+template <uint8_t operation, typename word_t>
+static inline word_t blendLayer(word_t value, word_t source, word_t select)
+{
+    switch (operation)
+    {
+        case LAYER_OR:
+
+            return value | (source & select);
+
+        case LAYER_AND:
+
+            return value & (source | (word_t)~select);
+
+        case LAYER_XOR:
+
+            return value ^ (source & select);
+
+        default: // LAYER_REPLACE
+
+            return (value & (word_t)~select) | (source & select);
+    }
+}
+
+template <uint8_t operation>
+void Screen_EPD_EXT3_Fast::flush_blendLayer(uint8_t * data, const uint8_t * layer, const uint8_t * mask)
+{
+    // Native words, 32 or 64 bits, rows not aligned
+    uint16_t index = 0;
+    for (; index + sizeof(size_t) <= u_bufferSizeH; index += sizeof(size_t))
+    {
+        size_t value, source;
+        size_t select = ~(size_t)0;
+        memcpy(&value, data + index, sizeof(size_t));
+        memcpy(&source, layer + index, sizeof(size_t));
+        if (mask != 0)
+        {
+            memcpy(&select, mask + index, sizeof(size_t));
+        }
+        value = blendLayer<operation, size_t>(value, source, select);
+        memcpy(data + index, &value, sizeof(size_t));
+    }
+
+    // Remaining bytes
+    for (; index < u_bufferSizeH; index++)
+    {
+        data[index] = blendLayer<operation, uint8_t>(data[index], layer[index], (mask != 0) ? mask[index] : 0xff);
+    }
+}
+
+template <uint8_t operation>
+void Screen_EPD_EXT3_Fast::flush_blendRows(uint8_t ** rows, uint8_t count, uint16_t first, const flushLayer_s & layer)
+{
+    if (!layer.surface->transposed)
+    {
+        for (uint8_t index = 0; index < count; index++)
+        {
+            uint32_t offset = (uint32_t)(first + index) * u_bufferSizeH;
+            flush_blendLayer<operation>(rows[index], layer.surface->data + offset, (layer.mask != 0) ? layer.mask->data + offset : 0);
+        }
+        return;
+    }
+
+    // One 8x8 block per byte of the rows, 8 transposed rows with byte first / 8
+    uint16_t rowSize = layer.surface->rowSize;
+    for (uint16_t column = 0; column < u_bufferSizeH; column++)
+    {
+        uint8_t source[8];
+        uint8_t select[8] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+        uint32_t offset = (uint32_t)column * 8 * rowSize + (first >> 3);
+        transpose8x8(layer.surface->data + offset, rowSize, source);
+        if (layer.mask != 0)
+        {
+            transpose8x8(layer.mask->data + offset, rowSize, select);
+        }
+
+        // Rows beyond the panel ignored
+        for (uint8_t index = 0; index < count; index++)
+        {
+            rows[index][column] = blendLayer<operation, uint8_t>(rows[index][column], source[index], select[index]);
+        }
+    }
+}
+
+void Screen_EPD_EXT3_Fast::_copyBits(uint8_t * target, uint16_t first, const uint8_t * source, uint16_t start, uint16_t count)
+{
+    uint16_t last = first + count - 1;
+    uint16_t byteFirst = first >> 3;
+    uint16_t byteLast = last >> 3;
+    uint8_t maskFirst = 0xff >> (first & 0x07);
+    uint8_t maskLast = 0xff << (7 - (last & 0x07));
+
+    if ((first & 0x07) == (start & 0x07))
+    {
+        // Same alignment, whole bytes in between partial bytes at both ends
+        const uint8_t * from = source + (start >> 3);
+        if (byteFirst == byteLast)
+        {
+            uint8_t mask = maskFirst & maskLast;
+            target[byteFirst] = (target[byteFirst] & ~mask) | (from[0] & mask);
+            return;
+        }
+
+        target[byteFirst] = (target[byteFirst] & ~maskFirst) | (from[0] & maskFirst);
+        memcpy(target + byteFirst + 1, from + 1, byteLast - byteFirst - 1);
+        target[byteLast] = (target[byteLast] & ~maskLast) | (from[byteLast - byteFirst] & maskLast);
+        return;
+    }
+
+    // Different alignment, each byte of target from two bytes of source
+    while (count > 0)
+    {
+        uint8_t offset = first & 0x07;
+        uint8_t shift = start & 0x07;
+        uint8_t bits = (count < 8 - offset) ? count : 8 - offset;
+        uint8_t value = source[start >> 3] << shift;
+        if (shift + bits > 8)
+        {
+            value |= source[(start >> 3) + 1] >> (8 - shift);
+        }
+        uint8_t mask = (0xff >> offset) & (uint8_t)(0xff << (8 - offset - bits));
+        target[first >> 3] = (target[first >> 3] & ~mask) | ((value >> offset) & mask);
+
+        first += bits;
+        start += bits;
+        count -= bits;
+    }
+}
+
+void Screen_EPD_EXT3_Fast::regenerate()
+{
+    // Same sequence as non-blocking regeneration, waiting at each stage
+    regenerate_nonBlocking();
+    while (isBusy())
+    {
+        if (flushState != kReady)
+        {
+            b_waitBusy(nextBusyPinState);
+        }
+        else
+        {
+            delay(1);
+        }
+        flush_task();
+    }
+}
+
+void Screen_EPD_EXT3_Fast::regenerate_nonBlocking()
+{
+    clear(myColours.black);
+    flush_nonBlocking();
+    flushRegenerateSequence = flush_target();
+    flushRegenerate = 1;
+}
+
+bool Screen_EPD_EXT3_Fast::setScreenCache(uint8_t slots)
+{
+    if ((u_newImage == 0) or (cacheSlots != 0) or (slots == 0) or (bandRows > 0) or flushTiled or (flushStorage != 0)) // begin() not yet called, cache already set, or no frame-buffer
+    {
+        return false;
+    }
+
+    uint32_t size = u_pageColourSize * slots;
+
+#if defined(BOARD_HAS_PSRAM) // ESP32 PSRAM specific case
+
+    cacheData = (uint8_t *) ps_malloc(size);
+
+#else // default case
+
+    cacheData = new uint8_t[size];
+
+#endif // ESP32 BOARD_HAS_PSRAM
+
+    if (cacheData == 0)
+    {
+        return false;
+    }
+
+    cacheSlots = new cacheSlot_s[slots];
+    for (uint8_t slot = 0; slot < slots; slot++)
+    {
+        cacheSlots[slot].key = 0; // empty
+        cacheSlots[slot].used = 0;
+    }
+    cacheSlotCount = slots;
+    cacheClock = 0;
+    return true;
+}
+
+uint32_t Screen_EPD_EXT3_Fast::getScreenHash()
+{
+    uint32_t hash = 2166136261;
+    if (bandRows > 0)
+    {
+        // FNV-1a on the display list of the next frame
+        for (uint32_t index = listStart; index < listUsed; index++)
+        {
+            hash = (hash ^ listData[index]) * 16777619;
+        }
+        return (hash != 0) ? hash : 1;
+    }
+
+    if (flushTiled)
+    {
+        // FNV-1a on the tiles of the next frame, value of uniform tiles
+        for (uint16_t index = 0; index < tilesH * tilesV; index++)
+        {
+            const flushTile_s & tile = flushTiles[index];
+            uint8_t page = (tile.flags & FLUSH_TILE_STALE) ? 1 : 0;
+            if (tile.slot[page] == FLUSH_TILE_UNIFORM)
+            {
+                hash = (hash ^ tile.value[page]) * 16777619;
+                continue;
+            }
+            for (uint16_t offset = 0; offset < FLUSH_TILE_BYTES; offset++)
+            {
+                hash = (hash ^ tilePool[(uint32_t)tile.slot[page] * FLUSH_TILE_BYTES + offset]) * 16777619;
+            }
+        }
+        return (hash != 0) ? hash : 1;
+    }
+
+    // FNV-1a on the row hashes, rows drawn since last hash updated first
+    flush_scanRows();
+
+    for (uint16_t row = 0; row < u_bufferSizeV; row++)
+    {
+        hash = (hash ^ flushRows[row].hash[0]) * 16777619;
+    }
+    return (hash != 0) ? hash : 1; // 0 reserved for empty slot
+}
+
+uint32_t Screen_EPD_EXT3_Fast::saveScreenCache(uint32_t key)
+{
+    if (cacheSlots == 0)
+    {
+        return 0;
+    }
+
+    if (key == 0)
+    {
+        key = getScreenHash();
+    }
+
+    // Same key, or empty slot, or least recently used
+    uint8_t target = 0;
+    for (uint8_t slot = 0; slot < cacheSlotCount; slot++)
+    {
+        if (cacheSlots[slot].key == key)
+        {
+            target = slot;
+            break;
+        }
+        if (cacheSlots[slot].used < cacheSlots[target].used)
+        {
+            target = slot;
+        }
+    }
+
+    uint8_t * data = cacheData + (uint32_t)target * u_pageColourSize;
+    for (uint16_t row = 0; row < u_bufferSizeV; row++)
+    {
+        memcpy(data + (uint32_t)row * u_bufferSizeH, flush_row(row, 0), u_bufferSizeH);
+    }
+
+    cacheSlots[target].key = key;
+    cacheSlots[target].used = ++cacheClock;
+    return key;
+}
+
+bool Screen_EPD_EXT3_Fast::loadScreenCache(uint32_t key)
+{
+    if ((cacheSlots == 0) or (key == 0))
+    {
+        return false;
+    }
+
+    for (uint8_t slot = 0; slot < cacheSlotCount; slot++)
+    {
+        if (cacheSlots[slot].key == key)
+        {
+            // One copy per row, rows marked as drawn
+            const uint8_t * data = cacheData + (uint32_t)slot * u_pageColourSize;
+            for (uint16_t row = 0; row < u_bufferSizeV; row++)
+            {
+                flush_touchRow(row, true);
+                flushRows[row].flags |= FLUSH_ROW_DIRTY;
+                memcpy(flush_row(row, 0), data + (uint32_t)row * u_bufferSizeH, u_bufferSizeH);
+            }
+            flushDirty = true;
+
+            cacheSlots[slot].used = ++cacheClock;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t Screen_EPD_EXT3_Fast::getFlushChangedBytes()
+{
+    return flushChangedBytes;
+}
+
+void Screen_EPD_EXT3_Fast::setRegeneration(uint16_t threshold, uint32_t idle)
+{
+    flushGhostingThreshold = threshold;
+    flushGhostingIdle = idle;
+}
+
+uint16_t Screen_EPD_EXT3_Fast::getGhosting(uint8_t region)
+{
+    if ((region >= FLUSH_REGIONS) or (u_bufferSizeV == 0))
+    {
+        return 0;
+    }
+
+    // Toggles per pixel, in %
+    uint32_t pixels = ((uint32_t)u_bufferSizeV * (region + 1) / FLUSH_REGIONS - (uint32_t)u_bufferSizeV * region / FLUSH_REGIONS) * u_bufferSizeH * 8;
+    uint32_t score = (uint64_t)flushToggles[region] * 100 / pixels;
+    return (score > UINT16_MAX) ? UINT16_MAX : score;
+}
+
+void Screen_EPD_EXT3_Fast::flush_maintain()
+{
+    if (flushState != kReady)
+    {
+        return;
+    }
+
+    // Cycle in progress, phases without interruption, 100 ms after each update
+    if (flushMaintenance > 0)
+    {
+        if (((int32_t)(flushCompleted - flushMaintenanceSequence) < 0) or (millis() - flushEndTime < 100))
+        {
+            return;
+        }
+
+        if (flushMaintenance < 3)
+        {
+            flushMaintenance++;
+            flush_start(UPDATE_FAST);
+            flushMaintenanceSequence = flushSequence;
+        }
+        else
+        {
+            flushMaintenance = 0;
+            flushToggles[flushMaintenanceRegion] = 0;
+        }
+        return;
+    }
+
+    // Idle time only, with the displayed image known
+    if (flushPending or (flushRegenerate > 0) or (u_newImage == 0) or (flushLost > 0) or (bandRows > 0) or flushTiled or (millis() - flushEndTime < flushGhostingIdle))
+    {
+        return;
+    }
+
+    // Worst region
+    uint8_t worst = 0;
+    uint16_t score = 0;
+    for (uint8_t region = 0; region < FLUSH_REGIONS; region++)
+    {
+        uint16_t ghosting = getGhosting(region);
+        if (ghosting > score)
+        {
+            score = ghosting;
+            worst = region;
+        }
+    }
+
+    if ((score < flushGhostingThreshold) or (checkTemperatureMode(UPDATE_FAST) != UPDATE_FAST))
+    {
+        return;
+    }
+
+    flushMaintenanceRegion = worst;
+    flushMaintenance = 1;
+    flush_start(UPDATE_FAST);
+    flushMaintenanceSequence = flushSequence;
+}
+
+void Screen_EPD_EXT3_Fast::flush_regenerate()
+{
+    // Wait for the update and 100 ms after
+    if (((int32_t)(flushCompleted - flushRegenerateSequence) < 0) or (millis() - flushEndTime < 100))
+    {
+        return;
+    }
+
+    if (flushRegenerate == 1)
+    {
+        clear(myColours.white);
+        flush_nonBlocking();
+        flushRegenerateSequence = flush_target();
+        flushRegenerate = 2;
+    }
+    else
+    {
+        flushRegenerate = 0;
+    }
+}
+
+void Screen_EPD_EXT3_Fast::_setPoint(uint16_t x1, uint16_t y1, uint16_t colour)
+{
+    // Writer for the current orientation, see _setOrientation()
+    (this->*pointWriter)(x1, y1, colour);
+}
+
+template <uint8_t orientation>
+void Screen_EPD_EXT3_Fast::_setPointOriented(uint16_t x1, uint16_t y1, uint16_t colour)
+{
+    // Orient and check coordinates are within screen
+    if (_orientPoint<orientation>(x1, y1) == RESULT_ERROR)
+    {
+        return;
+    }
+
+    // Colour resolved once for consecutive points of the same colour
+    if (colour != pointColour)
+    {
+        _resolveColour(colour);
+    }
+
+    uint8_t operation = pointOperation[(x1 + y1) & 0x01];
+    if (operation == POINT_NONE)
+    {
+        return;
+    }
+
+    // Row x1, byte y1 / 8, bit 7 - y1 % 8
+    flushRow_s & meta = flushRows[x1];
+    if (meta.flags & FLUSH_ROW_STALE)
+    {
+        flush_touchRow(x1);
+    }
+    uint8_t * data = u_newImage + ((meta.flags & FLUSH_ROW_PAGE) ? u_pageColourSize : 0) + (uint32_t)x1 * u_bufferSizeH + (y1 >> 3);
+    uint8_t mask = 0x80 >> (y1 & 0x07);
+
+    if (operation == POINT_CLEAR)
+    {
+        // physical black 00
+        *data &= ~mask;
+    }
+    else
+    {
+        // physical white 10
+        *data |= mask;
+    }
+
+    // Row x1 drawn
+    meta.flags |= FLUSH_ROW_DIRTY;
+    flushDirty = true;
+}
+
+template <uint8_t orientation>
+void Screen_EPD_EXT3_Fast::_setPointBanded(uint16_t x1, uint16_t y1, uint16_t colour)
+{
+    // Orient and check coordinates are within screen and band
+    if ((_orientPoint<orientation>(x1, y1) == RESULT_ERROR) or (x1 < bandFirst) or (x1 >= bandLast))
+    {
+        return;
+    }
+
+    if (colour != pointColour)
+    {
+        _resolveColour(colour);
+    }
+
+    uint8_t operation = pointOperation[(x1 + y1) & 0x01];
+    uint8_t * data = bandBuffer + (uint32_t)(x1 - bandFirst) * u_bufferSizeH + (y1 >> 3);
+    uint8_t mask = 0x80 >> (y1 & 0x07);
+
+    if (operation == POINT_CLEAR)
+    {
+        // physical black 00
+        *data &= ~mask;
+    }
+    else if (operation == POINT_SET)
+    {
+        // physical white 10
+        *data |= mask;
+    }
+}
+
+template <uint8_t orientation>
+uint16_t Screen_EPD_EXT3_Fast::_getPointBanded(uint16_t x1, uint16_t y1)
+{
+    if (_orientPoint<orientation>(x1, y1) == RESULT_ERROR)
+    {
+        return 0;
+    }
+
+    // Row of the next frame rasterised
+    flush_rasterise(x1, x1 + 1, listStart, listUsed);
+    uint8_t value = bandBuffer[y1 >> 3] & (0x80 >> (y1 & 0x07));
+
+    // red = 0-1, black = 1-0, white 0-0
+    return (value != 0) ? myColours.black : myColours.white;
+}
+
+template <uint8_t orientation>
+void Screen_EPD_EXT3_Fast::_setPointStored(uint16_t x1, uint16_t y1, uint16_t colour)
+{
+    if (_orientPoint<orientation>(x1, y1) == RESULT_ERROR)
+    {
+        return;
+    }
+
+    if (colour != pointColour)
+    {
+        _resolveColour(colour);
+    }
+
+    uint8_t operation = pointOperation[(x1 + y1) & 0x01];
+    if (operation == POINT_NONE)
+    {
+        return;
+    }
+
+    // Row x1 from the row cache, byte y1 / 8, bit 7 - y1 % 8
+    flushRow_s & meta = flushRows[x1];
+    if (meta.flags & FLUSH_ROW_STALE)
+    {
+        flush_touchRow(x1);
+    }
+    uint8_t * data = flush_row(x1, 0, FLUSH_ACCESS_WRITE) + (y1 >> 3);
+    uint8_t mask = 0x80 >> (y1 & 0x07);
+
+    if (operation == POINT_CLEAR)
+    {
+        // physical black 00
+        *data &= ~mask;
+    }
+    else
+    {
+        // physical white 10
+        *data |= mask;
+    }
+
+    meta.flags |= FLUSH_ROW_DIRTY;
+    flushDirty = true;
+}
+
+template <uint8_t orientation>
+void Screen_EPD_EXT3_Fast::_setPointTiled(uint16_t x1, uint16_t y1, uint16_t colour)
+{
+    if (_orientPoint<orientation>(x1, y1) == RESULT_ERROR)
+    {
+        return;
+    }
+
+    if (colour != pointColour)
+    {
+        _resolveColour(colour);
+    }
+
+    uint8_t operation = pointOperation[(x1 + y1) & 0x01];
+    if (operation == POINT_NONE)
+    {
+        return;
+    }
+
+    // Uniform tile unchanged, not materialised
+    uint16_t index = (x1 / FLUSH_TILE_SIZE) * tilesH + y1 / FLUSH_TILE_SIZE;
+    const flushTile_s & tile = flushTiles[index];
+    uint8_t page = (tile.flags & FLUSH_TILE_STALE) ? 1 : 0;
+    uint8_t mask = 0x80 >> (y1 & 0x07);
+    if ((tile.slot[page] == FLUSH_TILE_UNIFORM) and (((tile.value[page] & mask) != 0) == (operation == POINT_SET)))
+    {
+        return;
+    }
+
+    uint8_t * data = flush_touchTile(index);
+    if (data == 0)
+    {
+        return;
+    }
+    data += (x1 % FLUSH_TILE_SIZE) * (FLUSH_TILE_SIZE / 8) + (y1 % FLUSH_TILE_SIZE) / 8;
+
+    if (operation == POINT_CLEAR)
+    {
+        // physical black 00
+        *data &= ~mask;
+    }
+    else
+    {
+        // physical white 10
+        *data |= mask;
+    }
+    flushDirty = true;
+}
+
+template <uint8_t orientation>
+uint16_t Screen_EPD_EXT3_Fast::_getPointTiled(uint16_t x1, uint16_t y1)
+{
+    if (_orientPoint<orientation>(x1, y1) == RESULT_ERROR)
+    {
+        return 0;
+    }
+
+    const flushTile_s & tile = flushTiles[(x1 / FLUSH_TILE_SIZE) * tilesH + y1 / FLUSH_TILE_SIZE];
+    uint16_t offset = (x1 % FLUSH_TILE_SIZE) * (FLUSH_TILE_SIZE / 8) + (y1 % FLUSH_TILE_SIZE) / 8;
+    uint8_t value = flush_tileByte(tile, 0, offset) & (0x80 >> (y1 & 0x07));
+
+    // red = 0-1, black = 1-0, white 0-0
+    return (value != 0) ? myColours.black : myColours.white;
+}
+
+template <uint8_t orientation, bool transposed>
+void Screen_EPD_EXT3_Fast::_setPointLayer(uint16_t x1, uint16_t y1, uint16_t colour)
+{
+    if (_orientPoint<orientation>(x1, y1) == RESULT_ERROR)
+    {
+        return;
+    }
+
+    if (colour != pointColour)
+    {
+        _resolveColour(colour);
+    }
+
+    uint8_t operation = pointOperation[(x1 + y1) & 0x01];
+    if (operation == POINT_NONE)
+    {
+        return;
+    }
+
+    // Row x1 of the layer, byte y1 / 8, bit 7 - y1 % 8, or row y1, byte x1 / 8, bit 7 - x1 % 8 if transposed
+    uint8_t * data;
+    uint8_t mask;
+    if (transposed)
+    {
+        data = layerTarget->data + (uint32_t)y1 * layerTarget->rowSize + (x1 >> 3);
+        mask = 0x80 >> (x1 & 0x07);
+    }
+    else
+    {
+        data = layerTarget->data + (uint32_t)x1 * u_bufferSizeH + (y1 >> 3);
+        mask = 0x80 >> (y1 & 0x07);
+    }
+
+    if (operation == POINT_CLEAR)
+    {
+        *data &= ~mask;
+    }
+    else
+    {
+        *data |= mask;
+    }
+
+    layerFirst = min(layerFirst, x1);
+    layerLast = max(layerLast, x1);
+}
+
+template <uint8_t orientation, bool transposed>
+uint16_t Screen_EPD_EXT3_Fast::_getPointLayer(uint16_t x1, uint16_t y1)
+{
+    if (_orientPoint<orientation>(x1, y1) == RESULT_ERROR)
+    {
+        return 0;
+    }
+
+    uint8_t value;
+    if (transposed)
+    {
+        value = layerTarget->data[(uint32_t)y1 * layerTarget->rowSize + (x1 >> 3)] & (0x80 >> (x1 & 0x07));
+    }
+    else
+    {
+        value = layerTarget->data[(uint32_t)x1 * u_bufferSizeH + (y1 >> 3)] & (0x80 >> (y1 & 0x07));
+    }
+    return (value != 0) ? myColours.black : myColours.white;
+}
+
+void Screen_EPD_EXT3_Fast::_setSpanH(uint16_t x1, uint16_t x2, uint16_t y1, uint16_t colour)
+{
+    _setRectangle(x1, y1, x2, y1, colour);
+}
+
+void Screen_EPD_EXT3_Fast::_setSpanV(uint16_t x1, uint16_t y1, uint16_t y2, uint16_t colour)
+{
+    _setRectangle(x1, y1, x1, y2, colour);
+}
+
+void Screen_EPD_EXT3_Fast::_setRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour)
+{
+    // Clip to screen, points outside are ignored
+    uint16_t sizeX = screenSizeX();
+    uint16_t sizeY = screenSizeY();
+    if ((x1 >= sizeX) or (y1 >= sizeY))
+    {
+        return;
+    }
+    x2 = min(x2, (uint16_t)(sizeX - 1));
+    y2 = min(y2, (uint16_t)(sizeY - 1));
+
+    // Colour resolved once for the whole rectangle
+    if (colour != pointColour)
+    {
+        _resolveColour(colour);
+    }
+    if ((pointOperation[0] == POINT_NONE) and (pointOperation[1] == POINT_NONE))
+    {
+        return;
+    }
+
+    // Physical rectangle, rows and columns of the frame-buffer
+    _orientCoordinates(x1, y1);
+    _orientCoordinates(x2, y2);
+    if (x1 > x2)
+    {
+        swap(x1, x2);
+    }
+    if (y1 > y2)
+    {
+        swap(y1, y2);
+    }
+
+    if (layerTarget != 0)
+    {
+        // Layer selected, rows of the layer, or columns if transposed
+        if (layerTarget->transposed)
+        {
+            for (uint16_t column = y1; column <= y2; column++)
+            {
+                _fillBytes(layerTarget->data + (uint32_t)column * layerTarget->rowSize, column, x1, x2);
+            }
+        }
+        else
+        {
+            for (uint16_t row = x1; row <= x2; row++)
+            {
+                _fillBytes(layerTarget->data + (uint32_t)row * u_bufferSizeH, row, y1, y2);
+            }
+        }
+        layerFirst = min(layerFirst, x1);
+        layerLast = max(layerLast, x2);
+        return;
+    }
+
+    if (bandRows > 0)
+    {
+        // Banded mode, rows of the band only
+        x1 = max(x1, bandFirst);
+        for (uint16_t row = x1; (row <= x2) and (row < bandLast); row++)
+        {
+            _fillBytes(bandBuffer + (uint32_t)(row - bandFirst) * u_bufferSizeH, row, y1, y2);
+        }
+        return;
+    }
+
+    if (flushTiled)
+    {
+        _fillTiles(x1, y1, x2, y2);
+        return;
+    }
+
+    for (uint16_t row = x1; row <= x2; row++)
+    {
+        _fillRow(row, y1, y2);
+    }
+}
+
+void Screen_EPD_EXT3_Fast::_fillRow(uint16_t row, uint16_t first, uint16_t last)
+{
+    flushRow_s & meta = flushRows[row];
+    if (meta.flags & FLUSH_ROW_STALE)
+    {
+        flush_touchRow(row);
+    }
+    _fillBytes(flush_row(row, 0, FLUSH_ACCESS_WRITE), row, first, last);
+
+    // Row drawn
+    meta.flags |= FLUSH_ROW_DIRTY;
+    flushDirty = true;
+}
+
+void Screen_EPD_EXT3_Fast::_fillTiles(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+    // Physical rectangle, tile by tile
+    for (uint16_t tileRow = x1 / FLUSH_TILE_SIZE; tileRow <= x2 / FLUSH_TILE_SIZE; tileRow++)
+    {
+        uint16_t rowFirst = max(x1, (uint16_t)(tileRow * FLUSH_TILE_SIZE));
+        uint16_t rowLast = min(x2, (uint16_t)(tileRow * FLUSH_TILE_SIZE + FLUSH_TILE_SIZE - 1));
+        uint16_t rowEnd = min((uint16_t)(tileRow * FLUSH_TILE_SIZE + FLUSH_TILE_SIZE - 1), (uint16_t)(u_bufferSizeV - 1));
+
+        for (uint16_t tileColumn = y1 / FLUSH_TILE_SIZE; tileColumn <= y2 / FLUSH_TILE_SIZE; tileColumn++)
+        {
+            uint16_t index = tileRow * tilesH + tileColumn;
+            uint16_t columnStart = tileColumn * FLUSH_TILE_SIZE;
+            uint16_t columnFirst = max(y1, columnStart);
+            uint16_t columnLast = min(y2, (uint16_t)(columnStart + FLUSH_TILE_SIZE - 1));
+            uint16_t columnEnd = min((uint16_t)(columnStart + FLUSH_TILE_SIZE - 1), (uint16_t)(u_bufferSizeH * 8 - 1));
+            flushDirty = true;
+
+            // Whole tile of one colour, uniform
+            if ((rowFirst == tileRow * FLUSH_TILE_SIZE) and (rowLast == rowEnd) and (columnFirst == columnStart) and (columnLast == columnEnd) and
+                    (pointOperation[0] == pointOperation[1]))
+            {
+                flush_setTile(index, (pointOperation[0] == POINT_SET) ? 0xff : 0x00);
+                continue;
+            }
+
+            // Uniform tile unchanged, not materialised
+            const flushTile_s & tile = flushTiles[index];
+            uint8_t page = (tile.flags & FLUSH_TILE_STALE) ? 1 : 0;
+            if (tile.slot[page] == FLUSH_TILE_UNIFORM)
+            {
+                bool unchanged = true;
+                for (uint16_t row = rowFirst; (row <= rowLast) and (row <= rowFirst + 1); row++)
+                {
+                    uint8_t setBits, clearBits;
+                    _fillBits(row, setBits, clearBits);
+                    unchanged = unchanged and (((tile.value[page] & ~clearBits) | setBits) == tile.value[page]);
+                }
+                if (unchanged)
+                {
+                    continue;
+                }
+            }
+
+            uint8_t * data = flush_touchTile(index);
+            if (data == 0)
+            {
+                continue;
+            }
+            for (uint16_t row = rowFirst; row <= rowLast; row++)
+            {
+                _fillBytes(data + (row - tileRow * FLUSH_TILE_SIZE) * (FLUSH_TILE_SIZE / 8), row, columnFirst - columnStart, columnLast - columnStart);
+            }
+        }
+    }
+}
+
+void Screen_EPD_EXT3_Fast::_fillBits(uint16_t row, uint8_t & setBits, uint8_t & clearBits)
+{
+    // Bits by parity of row + column, 0x80 for column 0
+    uint8_t even = (row & 0x01) ? 0x55 : 0xaa;
+    setBits = ((pointOperation[0] == POINT_SET) ? even : 0x00) | ((pointOperation[1] == POINT_SET) ? (uint8_t)~even : 0x00);
+    clearBits = ((pointOperation[0] == POINT_CLEAR) ? even : 0x00) | ((pointOperation[1] == POINT_CLEAR) ? (uint8_t)~even : 0x00);
+}
+
+void Screen_EPD_EXT3_Fast::_fillBytes(uint8_t * data, uint16_t row, uint16_t first, uint16_t last)
+{
+    uint8_t setBits, clearBits;
+    _fillBits(row, setBits, clearBits);
+
+    // Partial bytes at both ends, full bytes in between
+    uint16_t byteFirst = first >> 3;
+    uint16_t byteLast = last >> 3;
+    uint8_t maskFirst = 0xff >> (first & 0x07);
+    uint8_t maskLast = 0xff << (7 - (last & 0x07));
+
+    if (byteFirst == byteLast)
+    {
+        uint8_t mask = maskFirst & maskLast;
+        data[byteFirst] = (data[byteFirst] & ~(mask & clearBits)) | (mask & setBits);
+    }
+    else
+    {
+        data[byteFirst] = (data[byteFirst] & ~(maskFirst & clearBits)) | (maskFirst & setBits);
+
+        if ((setBits | clearBits) == 0xff)
+        {
+            memset(data + byteFirst + 1, setBits, byteLast - byteFirst - 1);
+        }
+        else
         {
-            indexE5_work[0] = indexE5_data[0]; // Temperature
-            index00_work[0] = index00_data[0]; // PSR0
-            index00_work[1] = index00_data[1]; // PSR1
-        } // u_codeExtra updateMode
+            for (uint16_t index = byteFirst + 1; index < byteLast; index++)
+            {
+                data[index] = (data[index] & ~clearBits) | setBits;
+            }
+        }
 
-        // New algorithm
-        uint8_t index00_reset[] = {0x0e};
-        b_sendIndexData(0x00, index00_reset, 1); // Soft-reset
-        nextBusyPinState = HIGH;
-        flushState = kCOGInitial_2;
+        data[byteLast] = (data[byteLast] & ~(maskLast & clearBits)) | (maskLast & setBits);
     }
 }
 
-void Screen_EPD_EXT3_Fast::clear(uint16_t colour)
+void Screen_EPD_EXT3_Fast::_resolveColour(uint16_t colour)
 {
-    if (colour == myColours.grey)
+    pointColour = colour;
+
+    // Convert combined colours into basic colours, grey black on even points
+    for (uint8_t parity = 0; parity < 2; parity++)
     {
-        for (uint16_t i = 0; i < u_bufferSizeV; i++)
+        uint16_t basic = colour;
+        if (colour == myColours.grey)
         {
-            uint16_t pattern = (i % 2) ? 0b10101010 : 0b01010101;
-            for (uint16_t j = 0; j < u_bufferSizeH; j++)
-            {
-                u_newImage[i * u_bufferSizeH + j] = pattern;
-            }
+            basic = (parity == 0) ? myColours.black : myColours.white;
+        }
+
+        if (basic == myColours.white)
+        {
+            pointOperation[parity] = POINT_CLEAR;
+        }
+        else if (basic == myColours.black)
+        {
+            pointOperation[parity] = POINT_SET;
+        }
+        else
+        {
+            pointOperation[parity] = POINT_NONE;
         }
-    }
-    else if ((colour == myColours.white) xor u_invert)
-    {
-        // physical black 00
-        memset(u_newImage, 0x00, u_pageColourSize);
-    }
-    else
-    {
-        // physical white 10
-        memset(u_newImage, 0xff, u_pageColourSize);
     }
 }
 
-void Screen_EPD_EXT3_Fast::regenerate()
+void Screen_EPD_EXT3_Fast::_setOrientation(uint8_t orientation)
 {
-    clear(myColours.black);
-    flush();
-    delay(100);
-
-    clear(myColours.white);
-    flush();
-    delay(100);
-}
+    _orientation = orientation % 4;
 
-void Screen_EPD_EXT3_Fast::_setPoint(uint16_t x1, uint16_t y1, uint16_t colour)
-{
-    // Orient and check coordinates are within screen
-    // _orientCoordinates() returns false = success, true = error
-    if (_orientCoordinates(x1, y1) == RESULT_ERROR)
+    // Banded mode, points clipped to the band
+    if (bandRows > 0)
     {
+        switch (_orientation)
+        {
+            case 3:
+
+                pointWriter = &Screen_EPD_EXT3_Fast::_setPointBanded<3>;
+                pointReader = &Screen_EPD_EXT3_Fast::_getPointBanded<3>;
+                break;
+
+            case 2:
+
+                pointWriter = &Screen_EPD_EXT3_Fast::_setPointBanded<2>;
+                pointReader = &Screen_EPD_EXT3_Fast::_getPointBanded<2>;
+                break;
+
+            case 1:
+
+                pointWriter = &Screen_EPD_EXT3_Fast::_setPointBanded<1>;
+                pointReader = &Screen_EPD_EXT3_Fast::_getPointBanded<1>;
+                break;
+
+            default:
+
+                pointWriter = &Screen_EPD_EXT3_Fast::_setPointBanded<0>;
+                pointReader = &Screen_EPD_EXT3_Fast::_getPointBanded<0>;
+                break;
+        }
         return;
     }
 
-    // Convert combined colours into basic colours
-    bool flagOdd = ((x1 + y1) % 2 == 0);
-
-    if (colour == myColours.grey)
+    // Layer selected, points written into the layer
+    if (layerTarget != 0)
     {
-        if (flagOdd)
+        bool transposed = layerTarget->transposed;
+        switch (_orientation)
         {
-            colour = myColours.black; // black
+            case 3:
+
+                pointWriter = transposed ? &Screen_EPD_EXT3_Fast::_setPointLayer<3, true> : &Screen_EPD_EXT3_Fast::_setPointLayer<3, false>;
+                pointReader = transposed ? &Screen_EPD_EXT3_Fast::_getPointLayer<3, true> : &Screen_EPD_EXT3_Fast::_getPointLayer<3, false>;
+                break;
+
+            case 2:
+
+                pointWriter = transposed ? &Screen_EPD_EXT3_Fast::_setPointLayer<2, true> : &Screen_EPD_EXT3_Fast::_setPointLayer<2, false>;
+                pointReader = transposed ? &Screen_EPD_EXT3_Fast::_getPointLayer<2, true> : &Screen_EPD_EXT3_Fast::_getPointLayer<2, false>;
+                break;
+
+            case 1:
+
+                pointWriter = transposed ? &Screen_EPD_EXT3_Fast::_setPointLayer<1, true> : &Screen_EPD_EXT3_Fast::_setPointLayer<1, false>;
+                pointReader = transposed ? &Screen_EPD_EXT3_Fast::_getPointLayer<1, true> : &Screen_EPD_EXT3_Fast::_getPointLayer<1, false>;
+                break;
+
+            default:
+
+                pointWriter = transposed ? &Screen_EPD_EXT3_Fast::_setPointLayer<0, true> : &Screen_EPD_EXT3_Fast::_setPointLayer<0, false>;
+                pointReader = transposed ? &Screen_EPD_EXT3_Fast::_getPointLayer<0, true> : &Screen_EPD_EXT3_Fast::_getPointLayer<0, false>;
+                break;
         }
-        else
+        return;
+    }
+
+    // Storage mode, points written into the row cache
+    if (flushStorage != 0)
+    {
+        switch (_orientation)
         {
-            colour = myColours.white; // white
+            case 3:
+
+                pointWriter = &Screen_EPD_EXT3_Fast::_setPointStored<3>;
+                pointReader = &Screen_EPD_EXT3_Fast::_getPointOriented<3>;
+                break;
+
+            case 2:
+
+                pointWriter = &Screen_EPD_EXT3_Fast::_setPointStored<2>;
+                pointReader = &Screen_EPD_EXT3_Fast::_getPointOriented<2>;
+                break;
+
+            case 1:
+
+                pointWriter = &Screen_EPD_EXT3_Fast::_setPointStored<1>;
+                pointReader = &Screen_EPD_EXT3_Fast::_getPointOriented<1>;
+                break;
+
+            default:
+
+                pointWriter = &Screen_EPD_EXT3_Fast::_setPointStored<0>;
+                pointReader = &Screen_EPD_EXT3_Fast::_getPointOriented<0>;
+                break;
         }
+        return;
     }
 
-    // Coordinates
-    uint32_t z1 = _getZ(x1, y1);
-    uint16_t b1 = _getB(x1, y1);
-
-    // Basic colours
-    if ((colour == myColours.white) xor u_invert)
+    // Tiled mode, points written into tiles
+    if (flushTiled)
     {
-        // physical black 00
-        bitClear(u_newImage[z1], b1);
+        switch (_orientation)
+        {
+            case 3:
+
+                pointWriter = &Screen_EPD_EXT3_Fast::_setPointTiled<3>;
+                pointReader = &Screen_EPD_EXT3_Fast::_getPointTiled<3>;
+                break;
+
+            case 2:
+
+                pointWriter = &Screen_EPD_EXT3_Fast::_setPointTiled<2>;
+                pointReader = &Screen_EPD_EXT3_Fast::_getPointTiled<2>;
+                break;
+
+            case 1:
+
+                pointWriter = &Screen_EPD_EXT3_Fast::_setPointTiled<1>;
+                pointReader = &Screen_EPD_EXT3_Fast::_getPointTiled<1>;
+                break;
+
+            default:
+
+                pointWriter = &Screen_EPD_EXT3_Fast::_setPointTiled<0>;
+                pointReader = &Screen_EPD_EXT3_Fast::_getPointTiled<0>;
+                break;
+        }
+        return;
     }
-    else if ((colour == myColours.black) xor u_invert)
+
+    // Pixel paths specialised by orientation, selected once
+    switch (_orientation)
     {
-        // physical white 10
-        bitSet(u_newImage[z1], b1);
+        case 3:
+
+            pointWriter = &Screen_EPD_EXT3_Fast::_setPointOriented<3>;
+            pointReader = &Screen_EPD_EXT3_Fast::_getPointOriented<3>;
+            break;
+
+        case 2:
+
+            pointWriter = &Screen_EPD_EXT3_Fast::_setPointOriented<2>;
+            pointReader = &Screen_EPD_EXT3_Fast::_getPointOriented<2>;
+            break;
+
+        case 1:
+
+            pointWriter = &Screen_EPD_EXT3_Fast::_setPointOriented<1>;
+            pointReader = &Screen_EPD_EXT3_Fast::_getPointOriented<1>;
+            break;
+
+        default:
+
+            pointWriter = &Screen_EPD_EXT3_Fast::_setPointOriented<0>;
+            pointReader = &Screen_EPD_EXT3_Fast::_getPointOriented<0>;
+            break;
     }
 }
 
-void Screen_EPD_EXT3_Fast::_setOrientation(uint8_t orientation)
+bool Screen_EPD_EXT3_Fast::_orientCoordinates(uint16_t & x, uint16_t & y)
 {
-    _orientation = orientation % 4;
+    switch (_orientation)
+    {
+        case 3:
+
+            return _orientPoint<3>(x, y);
+
+        case 2:
+
+            return _orientPoint<2>(x, y);
+
+        case 1:
+
+            return _orientPoint<1>(x, y);
+
+        default:
+
+            return _orientPoint<0>(x, y);
+    }
 }
 
-bool Screen_EPD_EXT3_Fast::_orientCoordinates(uint16_t & x, uint16_t & y)
+template <uint8_t orientation>
+bool Screen_EPD_EXT3_Fast::_orientPoint(uint16_t & x, uint16_t & y)
 {
     bool _flagResult = RESULT_ERROR; // false = success, true = error
-    switch (_orientation)
+    switch (orientation)
     {
         case 3: // checked, previously 1
 
@@ -993,6 +4160,13 @@ uint32_t Screen_EPD_EXT3_Fast::_getZ(uint16_t x1, uint16_t y1)
 
     z1 = (uint32_t)x1 * u_bufferSizeH + (y1 >> 3);
 
+    // Row of the next page, up to date with previous page
+    flush_touchRow(x1);
+    if (flushRows[x1].flags & FLUSH_ROW_PAGE)
+    {
+        z1 += u_pageColourSize;
+    }
+
     return z1;
 }
 
@@ -1006,43 +4180,286 @@ uint16_t Screen_EPD_EXT3_Fast::_getB(uint16_t x1, uint16_t y1)
 }
 
 uint16_t Screen_EPD_EXT3_Fast::_getPoint(uint16_t x1, uint16_t y1)
+{
+    // Reader for the current orientation, see _setOrientation()
+    return (this->*pointReader)(x1, y1);
+}
+
+template <uint8_t orientation>
+uint16_t Screen_EPD_EXT3_Fast::_getPointOriented(uint16_t x1, uint16_t y1)
 {
     // Orient and check coordinates are within screen
-    // _orientCoordinates() returns false = success, true = error
-    if (_orientCoordinates(x1, y1) == RESULT_ERROR)
+    if (_orientPoint<orientation>(x1, y1) == RESULT_ERROR)
     {
         return 0;
     }
 
-    uint16_t _result = 0;
-    uint8_t _value = 0;
+    // Outdated row read from previous page, no copy
+    uint8_t value = flush_row(x1, 0)[y1 >> 3] & (0x80 >> (y1 & 0x07));
 
-    // Coordinates
-    uint32_t z1 = _getZ(x1, y1);
-    uint16_t b1 = _getB(x1, y1);
+    // red = 0-1, black = 1-0, white 0-0
+    return (value != 0) ? myColours.black : myColours.white;
+}
+//
+// === End of Class section
+//
 
-    _value = bitRead(u_newImage[z1], b1);
-    _value <<= 4;
-    _value &= 0b11110000;
+//
+// === Worker section
+//
+#if (WORKER_MODE != USE_WORKER_NONE)
 
-    // red = 0-1, black = 1-0, white 0-0
-    switch (_value)
+uint32_t Screen_EPD_EXT3_Fast::flush_post(uint32_t deadline)
+{
+    uint8_t tail = flushQueueTail.load(std::memory_order_relaxed);
+    if ((uint8_t)(tail - flushQueueHead.load(std::memory_order_acquire)) >= FLUSH_QUEUE_SIZE)
     {
-        case 0x10:
+        return 0; // Full
+    }
 
-            _result = myColours.black;
-            break;
+    flushPosted++;
+    if (flushPosted == 0) // 0 = rejected
+    {
+        flushPosted++;
+    }
+    flushQueue[tail % FLUSH_QUEUE_SIZE].deadline = deadline;
+    flushQueue[tail % FLUSH_QUEUE_SIZE].ticket = flushPosted;
+    flushQueueTail.store(tail + 1, std::memory_order_release);
 
-        default:
+    // Wake the worker
+#if (WORKER_MODE == USE_WORKER_THREAD)
+    {
+        std::lock_guard<std::mutex> lock(flushWorkerMutex);
+    }
+    flushWorkerWake.notify_one();
+#elif (WORKER_MODE == USE_WORKER_FREERTOS)
+    if (flushWorkerHandle != NULL)
+    {
+        xTaskNotifyGive(flushWorkerHandle);
+    }
+#endif // WORKER_MODE
 
-            _result = myColours.white;
-            break;
+    return flushPosted;
+}
+
+bool Screen_EPD_EXT3_Fast::flush_pop(flushRequest_s & request)
+{
+    uint8_t head = flushQueueHead.load(std::memory_order_relaxed);
+    if (head == flushQueueTail.load(std::memory_order_acquire))
+    {
+        return false; // Empty
+    }
+
+    request = flushQueue[head % FLUSH_QUEUE_SIZE];
+    flushQueueHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void Screen_EPD_EXT3_Fast::flush_work()
+{
+    // Requests, coalesced as per setFlushPolicy()
+    flushRequest_s request;
+    while (flush_pop(request))
+    {
+        flush_nonBlocking(request.deadline);
+
+        uint32_t sequence = flush_target();
+        flushTickets[sequence & 0x01] = request.ticket;
+        flushTicketSequences[sequence & 0x01] = sequence;
+    }
+
+    flush_task();
+
+    // Tickets displayed
+    for (uint8_t index = 0; index < 2; index++)
+    {
+        if ((flushTickets[index] > 0) and ((int32_t)(flushCompleted - flushTicketSequences[index]) >= 0))
+        {
+            flush_serve(flushTickets[index]);
+            flushTickets[index] = 0;
+        }
+    }
+}
+
+bool Screen_EPD_EXT3_Fast::flush_idle()
+{
+    return ((flushState == kReady) and (flushPending == false) and (flushQueueHead.load() == flushQueueTail.load()));
+}
+
+bool Screen_EPD_EXT3_Fast::flush_waitPosted(uint32_t ticket, uint32_t timeout)
+{
+#if (WORKER_MODE == USE_WORKER_THREAD)
+    std::unique_lock<std::mutex> lock(flushWorkerMutex);
+    return flushWorkerServed.wait_for(lock, std::chrono::milliseconds(timeout), [this, ticket]
+    {
+        return ((int32_t)(flushServed.load() - ticket) >= 0);
+    });
+
+#elif (WORKER_MODE == USE_WORKER_FREERTOS)
+    flushWaiterHandle = xTaskGetCurrentTaskHandle();
+    uint32_t chrono = millis();
+    while ((int32_t)(flushServed.load() - ticket) < 0)
+    {
+        uint32_t elapsed = millis() - chrono;
+        if (elapsed >= timeout)
+        {
+            flushWaiterHandle = NULL;
+            return false;
+        }
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout - elapsed));
+    }
+    flushWaiterHandle = NULL;
+    return true;
+#endif // WORKER_MODE
+}
+
+#if (WORKER_MODE == USE_WORKER_THREAD)
+
+void Screen_EPD_EXT3_Fast::flush_serve(uint32_t ticket)
+{
+    {
+        std::lock_guard<std::mutex> lock(flushWorkerMutex);
+        flushServed.store(ticket);
+    }
+    flushWorkerServed.notify_all();
+}
+
+bool Screen_EPD_EXT3_Fast::flush_beginWorker()
+{
+    if (flushWorkerRunning.load() or (u_newImage == 0))
+    {
+        return false;
+    }
+
+    flushWorkerRunning.store(true);
+    flushWorkerThread = std::thread([this]
+    {
+        while (flushWorkerRunning.load() or (flush_idle() == false))
+        {
+            flush_work();
+
+            // Sleep until next request, or poll the busy pin during the update
+            std::unique_lock<std::mutex> lock(flushWorkerMutex);
+            if (flush_idle())
+            {
+                flushWorkerWake.wait(lock, [this]
+                {
+                    return ((flushWorkerRunning.load() == false) or (flushQueueHead.load() != flushQueueTail.load()));
+                });
+            }
+            else
+            {
+                flushWorkerWake.wait_for(lock, std::chrono::milliseconds(1));
+            }
+        }
+    });
+    return true;
+}
+
+void Screen_EPD_EXT3_Fast::flush_endWorker()
+{
+    if (flushWorkerRunning.load() == false)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(flushWorkerMutex);
+        flushWorkerRunning.store(false);
+    }
+    flushWorkerWake.notify_one();
+    flushWorkerThread.join();
+}
+
+#elif (WORKER_MODE == USE_WORKER_FREERTOS)
+
+// Single worker, for the busy pin interrupt
+static Screen_EPD_EXT3_Fast * flushWorkerScreen = 0;
+
+void Screen_EPD_EXT3_Fast::flush_serve(uint32_t ticket)
+{
+    flushServed.store(ticket);
+
+    TaskHandle_t waiter = flushWaiterHandle;
+    if (waiter != NULL)
+    {
+        xTaskNotifyGive(waiter);
+    }
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+void IRAM_ATTR Screen_EPD_EXT3_Fast::flush_busyISR()
+#else
+void Screen_EPD_EXT3_Fast::flush_busyISR()
+#endif // ARDUINO_ARCH_ESP32
+{
+    BaseType_t woken = pdFALSE;
+    if ((flushWorkerScreen != 0) and (flushWorkerScreen->flushWorkerHandle != NULL))
+    {
+        vTaskNotifyGiveFromISR(flushWorkerScreen->flushWorkerHandle, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+void Screen_EPD_EXT3_Fast::flush_worker(void * parameters)
+{
+    Screen_EPD_EXT3_Fast * screen = (Screen_EPD_EXT3_Fast *)parameters;
+
+    while (screen->flushWorkerRunning.load() or (screen->flush_idle() == false))
+    {
+        screen->flush_work();
+
+        // Sleep until next request or busy pin edge
+        // Timeout for requests held by the pacing policy
+        ulTaskNotifyTake(pdTRUE, (screen->flush_idle() ? portMAX_DELAY : pdMS_TO_TICKS(10)));
+    }
+
+    detachInterrupt(digitalPinToInterrupt(screen->b_pin.panelBusy));
+    flushWorkerScreen = 0;
+    screen->flushWorkerHandle = NULL;
+    vTaskDelete(NULL);
+}
+
+bool Screen_EPD_EXT3_Fast::flush_beginWorker()
+{
+    if ((flushWorkerHandle != NULL) or (flushWorkerScreen != 0) or (u_newImage == 0))
+    {
+        return false;
+    }
+
+    flushWorkerScreen = this;
+    flushWorkerRunning.store(true);
+    if (xTaskCreate(flush_worker, "PDLS", 4096, this, 2, &flushWorkerHandle) != pdPASS)
+    {
+        flushWorkerRunning.store(false);
+        flushWorkerScreen = 0;
+        flushWorkerHandle = NULL;
+        return false;
+    }
+
+    attachInterrupt(digitalPinToInterrupt(b_pin.panelBusy), flush_busyISR, CHANGE);
+    return true;
+}
+
+void Screen_EPD_EXT3_Fast::flush_endWorker()
+{
+    if (flushWorkerHandle == NULL)
+    {
+        return;
     }
 
-    return _result;
+    flushWorkerRunning.store(false);
+    xTaskNotifyGive(flushWorkerHandle);
+    while (flushWorkerHandle != NULL)
+    {
+        delay(1);
+    }
 }
+
+#endif // WORKER_MODE
+#endif // WORKER_MODE
 //
-// === End of Class section
+// === End of Worker section
 //
 
 //
@@ -27,7 +27,7 @@
 ///
 /// @author Rei Vilo
 /// @date 21 Dec 2023
-/// @version 703
+/// @version 704
 ///
 /// @copyright (c) Rei Vilo, 2010-2023
 /// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
@@ -42,6 +42,22 @@
 /// @n Consider the Evaluation or Commercial editions for professionals or organisations and for commercial usage
 ///
 
+// Worker, see WORKER_MODE
+// Before hV_Utilities_Common.h and its min() max() macros
+#include "hV_List_Options.h"
+#if (WORKER_MODE == USE_WORKER_THREAD)
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#elif (WORKER_MODE == USE_WORKER_FREERTOS)
+#include <atomic>
+#if defined(ARDUINO_ARCH_RP2040)
+#include <FreeRTOS.h>
+#include <task.h>
+#endif // ARDUINO_ARCH_RP2040
+#endif // WORKER_MODE
+
 // SDK
 #include "hV_HAL_Peripherals.h"
 
@@ -57,6 +73,12 @@
 // PDLS utilities
 #include "hV_Utilities_PDLS.h"
 
+// Frame-buffer storage
+#include "hV_Storage.h"
+
+// Transposed layers
+#include "hV_Transpose.h"
+
 // Checks
 #if (hV_HAL_PERIPHERALS_RELEASE < 700)
 #error Required hV_HAL_PERIPHERALS_RELEASE 700
@@ -74,11 +96,15 @@
 #error Required hV_BOARD_RELEASE 700
 #endif // hV_BOARD_RELEASE
 
+#if (hV_STORAGE_RELEASE < 704)
+#error Required hV_STORAGE_RELEASE 704
+#endif // hV_STORAGE_RELEASE
+
 #ifndef SCREEN_EPD_EXT3_RELEASE
 ///
 /// @brief Library release number
 ///
-#define SCREEN_EPD_EXT3_RELEASE 703
+#define SCREEN_EPD_EXT3_RELEASE 704
 
 ///
 /// @brief Library variant
@@ -92,8 +118,419 @@
 #error Required hV_SCREEN_BUFFER_RELEASE 700
 #endif // hV_SCREEN_BUFFER_RELEASE
 
+// C++20 coroutines, if supported by the toolchain
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+
+///
+/// @brief Maximum number of coroutines awaiting an update
+///
+#define FLUSH_AWAITERS 4
+#endif // __cpp_impl_coroutine
+
+#if (WORKER_MODE != USE_WORKER_NONE)
+///
+/// @brief Size of the worker queue
+/// @note Power of 2
+///
+#define FLUSH_QUEUE_SIZE 8
+
+///
+/// @brief Request for the worker
+///
+struct flushRequest_s
+{
+    uint32_t deadline; ///< ms as per millis(), 0 = none
+    uint32_t ticket; ///< returned by flush_post()
+};
+#endif // WORKER_MODE
+
 // Objects
 //
+///
+/// @brief Flush pacing policy for non-blocking update
+/// @note Numbers are sequential and exclusive
+///
+/// @{
+#define FLUSH_POLICY_LATEST 0x00 ///< Latest request wins, minimum interval after previous update completion
+#define FLUSH_POLICY_RATE 0x01 ///< Maximum refresh rate, minimum interval between two update starts
+#define FLUSH_POLICY_DEADLINE 0x02 ///< Deadline-based, update started as late as possible to meet the earliest deadline
+/// @}
+
+///
+/// @brief Statistics for non-blocking update
+/// @details A request is either merged into another update, or started, or dropped
+/// * merged: the frame-buffer is displayed by an update pending or not yet uploaded, or nothing drawn since last upload, no additional update
+/// * dropped: the request is discarded and the frame-buffer not displayed
+/// @note Counters are reset by resetFlushStatistics()
+///
+struct flushStatistics_s
+{
+    uint32_t requested; ///< Requests received by flush_nonBlocking()
+    uint32_t started; ///< Updates actually started
+    uint32_t merged; ///< Requests served by an update pending or not yet uploaded, or with nothing drawn
+    uint32_t dropped; ///< Requests discarded, frame-buffer not displayed
+    uint32_t late; ///< Updates visible after their deadline
+    uint32_t redriven; ///< Rows uploaded without their previous row, single page only
+};
+
+///
+/// @brief Stages of the update for metrics
+/// @note Numbers are sequential and exclusive
+///
+/// @{
+#define FLUSH_STAGE_INITIAL 0 ///< Soft-reset and settings
+#define FLUSH_STAGE_SEND 1 ///< Frame-buffer upload
+#define FLUSH_STAGE_UPDATE 2 ///< Power-on and refresh, until visible
+#define FLUSH_STAGE_POWEROFF 3 ///< Power-off
+#define FLUSH_STAGES 4 ///< Number of stages
+/// @}
+
+///
+/// @brief Temperature bands for metrics
+/// @note Numbers are sequential and exclusive
+///
+/// @{
+#define FLUSH_BAND_COLD 0 ///< Below 15 °C
+#define FLUSH_BAND_NOMINAL 1 ///< From 15 to 30 °C
+#define FLUSH_BAND_HOT 2 ///< Above 30 °C
+#define FLUSH_BANDS 3 ///< Number of bands
+/// @}
+
+///
+/// @brief Number of log2 buckets for metrics
+/// @details Bucket n counts durations from 2^n to 2^(n+1) µs, last bucket counts longer durations
+///
+#define FLUSH_BUCKETS 24
+
+///
+/// @brief Metrics of one stage of the update
+/// @note Durations in µs, mean = total / count
+///
+struct flushMetrics_s
+{
+    uint32_t count; ///< Number of updates measured
+    uint32_t minimum; ///< Shortest duration
+    uint32_t maximum; ///< Longest duration
+    uint64_t total; ///< Sum of durations
+    uint16_t histogram[FLUSH_BUCKETS]; ///< Log2 buckets, saturated
+};
+
+///
+/// @brief Number of regions for ghosting score
+/// @details Regions are bands of the frame-buffer
+///
+#define FLUSH_REGIONS 8
+
+///
+/// @brief Panel descriptor
+/// @details All the properties of a panel, selected by size and film type
+/// @note sizeV = wide size, sizeH = small size
+///
+struct panelDescriptor_s
+{
+    uint16_t codeSizeType; ///< (u_codeSize << 8) | u_codeType, 0 = end of table
+    uint16_t sizeV; ///< Vertical = wide size, pixels
+    uint16_t sizeH; ///< Horizontal = small size, pixels
+    uint16_t diagonal; ///< Diagonal, 1/100 inch
+    uint8_t family; ///< FAMILY_SMALL or FAMILY_MEDIUM, sets the reset timings
+    uint8_t psr0; ///< PSR, first byte
+    uint8_t psr1; ///< PSR, second byte
+    bool flag50; ///< Additional Vcom settings for fast update, 154 213 266 370 437 screens
+    bool flag152; ///< 1.52" panel with different controller
+    bool noPSR; ///< No PSR, 0x4d and 0xe9 instead
+};
+
+///
+/// @brief Panel descriptors
+/// @note Last entry with codeSizeType = 0 for unsupported screens
+///
+constexpr panelDescriptor_s panelDescriptors[] =
+{
+    // codeSizeType sizeV sizeH diagonal family psr0 psr1 flag50 flag152 noPSR
+    { 0x150C, 152, 152, 154, FAMILY_SMALL, 0xcf, 0x02, true, false, false }, // 1.54"
+    { 0x154A, 200, 200, 152, FAMILY_SMALL, 0x00, 0x00, false, true, false }, // 1.52"
+    { 0x200E, 248, 128, 206, FAMILY_SMALL, 0xcf, 0x02, true, false, false }, // 2.06"
+    { 0x210E, 212, 104, 213, FAMILY_SMALL, 0xcf, 0x02, true, false, false }, // 2.13"
+    { 0x260C, 296, 152, 266, FAMILY_SMALL, 0xcf, 0x02, true, false, false }, // 2.66"
+    { 0x2709, 264, 176, 271, FAMILY_SMALL, 0xcf, 0x8d, false, false, false }, // 2.71" and 2.71"-Touch
+    { 0x2809, 296, 128, 287, FAMILY_SMALL, 0xcf, 0x8d, false, false, false }, // 2.87"
+    { 0x290F, 384, 168, 290, FAMILY_SMALL, 0x00, 0x00, false, false, true }, // 2.90"
+    { 0x370C, 416, 240, 370, FAMILY_SMALL, 0xcf, 0x8f, true, false, false }, // 3.70" and 3.70"-Touch
+    { 0x410D, 300, 400, 417, FAMILY_SMALL, 0x0f, 0x0e, false, false, false }, // 4.17"
+    { 0x430C, 480, 176, 437, FAMILY_SMALL, 0x0f, 0x0e, true, false, false }, // 4.37"
+    { 0x580B, 720, 256, 581, FAMILY_MEDIUM, 0xff, 0x8f, false, false, false }, // 5.81"
+    { 0x740B, 800, 480, 741, FAMILY_MEDIUM, 0xff, 0x8f, false, false, false }, // 7.41"
+    { 0x0000, 0, 0, 0, FAMILY_SMALL, 0xff, 0x8f, false, false, false } // Not supported
+};
+
+///
+/// @brief Get the descriptor of a panel
+/// @param eScreen_EPD_EXT3 size and type, see hV_List_Screens.h
+/// @param index first entry to check, default = 0
+/// @return descriptor, last entry if the screen is not supported
+/// @note Resolved at compile time when the screen is a constant, as in
+/// @code {.cpp}
+/// constexpr panelDescriptor_s panel = panelDescriptor(eScreen_EPD_EXT3_271_09_Fast);
+/// static_assert(panel.codeSizeType != 0, "Screen not supported");
+/// @endcode
+///
+constexpr panelDescriptor_s panelDescriptor(eScreen_EPD_EXT3_t eScreen_EPD_EXT3, uint8_t index = 0)
+{
+    return ((panelDescriptors[index].codeSizeType == 0x0000) or (panelDescriptors[index].codeSizeType == (eScreen_EPD_EXT3 & 0xffff))) ?
+           panelDescriptors[index] : panelDescriptor(eScreen_EPD_EXT3, index + 1);
+}
+
+///
+/// @brief Row metadata flags
+/// @note Numbers are bit-based and or-combinable
+///
+/// @{
+#define FLUSH_ROW_DIRTY 0x01 ///< Drawn since last upload
+#define FLUSH_ROW_CHANGED 0x02 ///< Next row differs from previous row
+#define FLUSH_ROW_UNIFORM 0x04 ///< Next row of one single byte value
+#define FLUSH_ROW_UNIFORM_PREVIOUS 0x08 ///< Previous row of one single byte value
+#define FLUSH_ROW_STALE 0x10 ///< Next row outdated, same as previous row, copied on first write
+#define FLUSH_ROW_PAGE 0x20 ///< Next row on second page, previous row on first page
+#define FLUSH_ROW_SAVED 0x40 ///< Single page, previous row saved before first write
+#define FLUSH_ROW_LOST 0x80 ///< Single page, previous row not saved, all pixels redriven
+/// @}
+
+///
+/// @brief Frame-buffer with next and previous pages
+/// @see Screen_EPD_EXT3_Fast::frameBufferSize()
+///
+#define FLUSH_PAGES_DOUBLE 0xffff
+
+///
+/// @brief Metadata of one row of the frame-buffer
+/// @details Next and previous rows swap pages when uploaded, instead of a copy
+/// @note Index 0 = next page, 1 = previous page
+///
+struct flushRow_s
+{
+    uint16_t hash[2]; ///< Content hash
+    uint8_t value[2]; ///< Byte value of uniform row
+    uint8_t flags; ///< FLUSH_ROW_* flags
+};
+
+///
+/// @brief Bit operations for a point
+/// @note Numbers are sequential and exclusive
+///
+/// @{
+#define POINT_NONE 0x00 ///< Colour not displayed
+#define POINT_CLEAR 0x01 ///< Bit cleared, physical black 00
+#define POINT_SET 0x02 ///< Bit set, physical white 10
+/// @}
+
+///
+/// @brief Compressed previous frame, single page only
+/// @note Durations in µs, last update
+///
+struct flushCompression_s
+{
+    uint32_t pageSize; ///< Bytes of one page
+    uint32_t compressedSize; ///< Bytes of the compressed previous frame, uniform rows excluded
+    uint16_t ratio; ///< Page size / compressed size, x100, 0 = not compressed
+    uint32_t encodeTime; ///< Compression of the displayed frame after upload
+    uint32_t decodeTime; ///< Decompression of the rows drawn, during upload
+};
+
+///
+/// @brief Commands of the display list, banded mode
+/// @details Header of 8 bytes: command, state, size, first and last physical rows
+/// @note Numbers are sequential and exclusive
+///
+/// @{
+#define LIST_CLEAR 0x01 ///< colour
+#define LIST_POINT 0x02 ///< x1 y1 colour
+#define LIST_LINE 0x03 ///< x1 y1 x2 y2 colour
+#define LIST_RECTANGLE 0x04 ///< x1 y1 x2 y2 colour
+#define LIST_CIRCLE 0x05 ///< x0 y0 radius colour
+#define LIST_TRIANGLE 0x06 ///< x1 y1 x2 y2 x3 y3 colour
+#define LIST_TEXT 0x07 ///< font, space x, space y, x0 y0 text colour, back colour, length, characters
+/// @}
+
+///
+/// @brief State of a command of the display list, orientation 0..3 and flags
+/// @note Numbers are bit-based and or-combinable
+///
+/// @{
+#define LIST_STATE_ORIENTATION 0x03 ///< Orientation mask
+#define LIST_STATE_PEN_SOLID 0x04 ///< Pen solid
+#define LIST_STATE_FONT_SOLID 0x08 ///< Font solid
+/// @}
+
+///
+/// @brief Display list, banded mode
+///
+struct displayList_s
+{
+    uint32_t size; ///< Bytes available
+    uint32_t used; ///< Bytes recorded, displayed and next frames
+    uint32_t displayed; ///< Bytes of the displayed frame
+    uint32_t dropped; ///< Drawing calls not recorded, display list full
+    uint32_t rasterTime; ///< µs, rasterisation of both frames for the last upload
+};
+
+///
+/// @brief Tiles, tiled mode
+/// @note Tile of FLUSH_TILE_SIZE rows by FLUSH_TILE_SIZE columns of the frame-buffer
+///
+/// @{
+#define FLUSH_TILE_SIZE 32 ///< Side of a tile in pixels, multiple of 8
+#define FLUSH_TILE_BYTES (FLUSH_TILE_SIZE * FLUSH_TILE_SIZE / 8) ///< Bytes of one slot of the tile pool
+#define FLUSH_TILE_UNIFORM 0xffff ///< Tile of one single byte value, no slot
+#define FLUSH_TILE_STALE 0x01 ///< Next tile outdated, same as previous tile, materialised on first write
+/// @}
+
+///
+/// @brief Metadata of one tile of the frame-buffer
+/// @details Next and previous tiles share the same slot until the first write
+/// @note Index 0 = next page, 1 = previous page
+///
+struct flushTile_s
+{
+    uint16_t slot[2]; ///< Slot in the tile pool, FLUSH_TILE_UNIFORM for a uniform tile
+    uint8_t value[2]; ///< Byte value of uniform tile
+    uint8_t flags; ///< FLUSH_TILE_* flags
+};
+
+///
+/// @brief Tile pool, tiled mode
+/// @note RAM in bytes
+///
+struct tilePool_s
+{
+    uint16_t tiles; ///< Tiles of one frame
+    uint16_t slots; ///< Slots of the tile pool
+    uint16_t used; ///< Slots used, next and previous frames
+    uint16_t peak; ///< Most slots used since begin
+    uint32_t dropped; ///< Writes not drawn, tile pool full
+    uint32_t peakSize; ///< Tile map and slots used at peak
+    uint32_t denseSize; ///< Frame-buffer with two pages, for comparison
+};
+
+///
+/// @brief Row cache, storage mode
+///
+struct rowCache_s
+{
+    uint16_t lines; ///< Rows of the row cache
+    uint32_t hits; ///< Rows found in the row cache
+    uint32_t misses; ///< Rows read from the storage
+    uint32_t writeBacks; ///< Rows written to the storage, modified and evicted
+};
+
+///
+/// @brief Line of the row cache
+///
+struct flushLine_s
+{
+    uint32_t address; ///< First byte of the row in the storage, FLUSH_LINE_EMPTY = empty
+    uint32_t used; ///< Last use, for LRU eviction
+    bool dirty; ///< Modified since read
+};
+
+///
+/// @brief Empty line of the row cache
+///
+#define FLUSH_LINE_EMPTY 0xffffffff
+
+///
+/// @brief Access to a row of the frame-buffer
+/// @note Numbers are bit-based and or-combinable
+///
+/// @{
+#define FLUSH_ACCESS_READ 0x00 ///< Row read
+#define FLUSH_ACCESS_WRITE 0x01 ///< Row modified
+#define FLUSH_ACCESS_WHOLE 0x03 ///< Row modified, all bytes written without read
+/// @}
+
+///
+/// @brief Slot of the screen cache
+///
+struct cacheSlot_s
+{
+    uint32_t key; ///< Application key or content hash, 0 = empty
+    uint32_t used; ///< Last use, for LRU eviction
+};
+
+///
+/// @brief Layouts of the offscreen surfaces
+/// @note Numbers are sequential and exclusive
+///
+/// @{
+#define SURFACE_LAYOUT_PANEL 0x00 ///< Rows of the panel, same as the frame-buffer
+#define SURFACE_LAYOUT_TRANSPOSED 0x01 ///< Columns of the panel stored as rows, layers only
+#define SURFACE_LAYOUT_ROWS 0x02 ///< Rows along the x-axis of the current orientation, transposed for orientations 1 and 3
+/// @}
+
+///
+/// @brief Offscreen surface
+/// @details Same bit layout as the frame-buffer, rows of bytes with 0x80 for the first column
+/// @n Transposed surfaces store the columns of the panel as rows, with 0x80 for the first row
+/// @note Allocated from the surface arena, see Screen_EPD_EXT3_Fast::setSurfaceArena()
+///
+struct surface_s
+{
+    uint8_t * data; ///< Rows
+    uint16_t rows; ///< Physical rows, physical columns if transposed
+    uint16_t columns; ///< Physical columns, 1 bit each, physical rows if transposed
+    uint16_t rowSize; ///< Bytes per row
+    bool transposed; ///< Columns of the panel stored as rows, see SURFACE_LAYOUT_TRANSPOSED
+    uint16_t row; ///< Physical row of the saved area, saveRect() only
+    uint16_t column; ///< Physical column of the saved area, saveRect() only
+};
+
+///
+/// @brief Surface arena
+///
+struct surfaceArena_s
+{
+    uint32_t size; ///< Bytes of the arena
+    uint32_t used; ///< Bytes allocated
+    uint32_t peak; ///< Highest bytes allocated
+};
+
+///
+/// @brief Number of layers
+///
+#define FLUSH_LAYERS 4
+
+///
+/// @brief Layer selected for drawing, none = frame-buffer
+///
+#define LAYER_SCREEN 0xff
+
+///
+/// @brief Blend operations of the layers, set bits for black
+/// @note Numbers are sequential and exclusive
+///
+/// @{
+#define LAYER_NONE 0x00 ///< Layer removed
+#define LAYER_REPLACE 0x01 ///< Layer replaces the layers below
+#define LAYER_OR 0x02 ///< Black of the layer over the layers below
+#define LAYER_AND 0x03 ///< Black where both the layer and the layers below are black
+#define LAYER_XOR 0x04 ///< Layers below inverted where the layer is black
+/// @}
+
+///
+/// @brief Layer, surface composited at flush
+///
+struct flushLayer_s
+{
+    surface_s * surface; ///< Full screen surface, 0 = none
+    surface_s * mask; ///< Full screen surface, bits set where the layer applies, 0 = whole layer
+    uint8_t operation; ///< LAYER_REPLACE, LAYER_OR, LAYER_AND or LAYER_XOR
+};
+
+///
+/// @brief Callback for non-blocking update
+///
+typedef void (*flushCallback_t)();
+
 ///
 /// @brief Class for Pervasive Displays iTC monochrome screens with embedded fast update
 /// @details Screen controllers
@@ -104,15 +541,15 @@
 /// @note All commands work on the frame-buffer,
 /// to be displayed on screen with flush()
 ///
-class Screen_EPD_EXT3_Fast final : public hV_Screen_Buffer, public hV_Utilities_PDLS
+class Screen_EPD_EXT3_Fast : public hV_Screen_Buffer, public hV_Utilities_PDLS
 {
   public:
     ///
     /// @brief Constructor with default pins
     /// @param eScreen_EPD_EXT3 size and model of the e-screen
     /// @param board board configuration
-    /// @note Frame-buffer generated by the class
-    /// @note To be used with begin() with no parameter
+    /// @note Frame-buffer generated by the class with begin(),
+    /// or provided by the caller with begin(uint8_t *, uint32_t)
     ///
     Screen_EPD_EXT3_Fast(eScreen_EPD_EXT3_t eScreen_EPD_EXT3, pins_t board);
 
@@ -123,6 +560,182 @@ class Screen_EPD_EXT3_Fast final : public hV_Screen_Buffer, public hV_Utilities_
     ///
     void begin();
 
+    ///
+    /// @brief Initialisation with frame-buffer provided by the caller
+    /// @param frameBuffer caller-owned memory, eg. in a chosen section or external RAM
+    /// @param size bytes, see frameBufferSize()
+    /// @return true if success, false if size too small
+    /// @details Size for two pages: next and previous frames, as begin()
+    /// @n Smaller size: single page for the next frame, previous frame rebuilt for the upload from
+    /// * the page for rows not drawn since last upload
+    /// * the row metadata for uniform rows
+    /// * the rows saved before their first write, as many as the remaining size allows
+    /// @note Other rows are uploaded with all their pixels redriven, see flushStatistics_s.redriven
+    /// @warning begin() initialises SPI and I2C
+    ///
+    /// @code {.cpp}
+    /// uint8_t buffer[Screen_EPD_EXT3_Fast::frameBufferSize(eScreen_EPD_EXT3_417_0D_Fast, 32)];
+    /// myScreen.begin(buffer, sizeof(buffer));
+    /// @endcode
+    ///
+    bool begin(uint8_t * frameBuffer, uint32_t size);
+
+    ///
+    /// @brief Size of the frame-buffer for begin(uint8_t *, uint32_t)
+    /// @param eScreen_EPD_EXT3 size and model of the e-screen
+    /// @param savedRows rows saved in single page mode, default = FLUSH_PAGES_DOUBLE for two pages
+    /// @return bytes, 0 if the screen is not supported
+    /// @note With setFlushCompression(), the space of the saved rows holds the compressed previous frame
+    ///
+    static constexpr uint32_t frameBufferSize(eScreen_EPD_EXT3_t eScreen_EPD_EXT3, uint16_t savedRows = FLUSH_PAGES_DOUBLE)
+    {
+        return (savedRows == FLUSH_PAGES_DOUBLE) ?
+               (uint32_t)panelDescriptor(eScreen_EPD_EXT3).sizeV * (panelDescriptor(eScreen_EPD_EXT3).sizeH / 8) * 2 :
+               ((uint32_t)panelDescriptor(eScreen_EPD_EXT3).sizeV + 1) * (panelDescriptor(eScreen_EPD_EXT3).sizeH / 8) +
+               (uint32_t)savedRows * (panelDescriptor(eScreen_EPD_EXT3).sizeH / 8 + 2);
+    }
+
+    ///
+    /// @brief Initialisation in banded mode, for panels larger than the RAM available
+    /// @details Drawing calls are recorded into a display list, without frame-buffer
+    /// @n For each upload, the panel is rasterised band by band into the band buffer and sent,
+    /// the previous frame from the display list of the last upload
+    /// @param workBuffer caller-owned memory, band buffer then display list
+    /// @param size bytes, band buffer and display list
+    /// @param bandRows rows of the band buffer, default = 16
+    /// @return true if success, false if size too small
+    /// @note Recorded: clear(), point(), line(), rectangle(), circle(), triangle(), gText() and variants
+    /// @note clear() starts a new display list, otherwise drawing calls accumulate
+    /// @note Reading a point rasterises its row
+    /// @warning Screen cache and automatic regeneration are not available
+    /// @warning begin() initialises SPI and I2C
+    ///
+    /// @code {.cpp}
+    /// static uint8_t workBuffer[16 * 480 / 8 + 8192]; // 7.41", 16 rows and 8 kB of display list
+    /// myScreen.beginBanded(workBuffer, sizeof(workBuffer), 16);
+    /// @endcode
+    ///
+    bool beginBanded(uint8_t * workBuffer, uint32_t size, uint16_t bandRows = 16);
+
+    ///
+    /// @brief Initialisation in tiled mode, for mostly blank screens
+    /// @details The frame-buffer is split into tiles of FLUSH_TILE_SIZE pixels
+    /// @n Uniform tiles are stored as one byte value, only the tiles drawn into take a slot of the tile pool
+    /// @n Next and previous tiles share their slot until the next tile is drawn
+    /// @param workBuffer caller-owned memory, tile map then tile pool
+    /// @param size bytes, see tiledBufferSize()
+    /// @return true if success, false if size too small
+    /// @note Tiles back to uniform are released before each upload, or when the tile pool is full
+    /// @note Writes to a new tile are not drawn when the tile pool is full, see getTilePool()
+    /// @warning Screen cache and automatic regeneration are not available
+    /// @warning begin() initialises SPI and I2C
+    ///
+    /// @code {.cpp}
+    /// uint8_t buffer[Screen_EPD_EXT3_Fast::tiledBufferSize(eScreen_EPD_EXT3_271_09_Fast, 16)];
+    /// myScreen.beginTiled(buffer, sizeof(buffer));
+    /// @endcode
+    ///
+    bool beginTiled(uint8_t * workBuffer, uint32_t size);
+
+    ///
+    /// @brief Size of the work buffer for beginTiled()
+    /// @param eScreen_EPD_EXT3 size and model of the e-screen
+    /// @param slots slots of the tile pool, for next and previous frames
+    /// @return bytes, 0 if the screen is not supported
+    ///
+    static constexpr uint32_t tiledBufferSize(eScreen_EPD_EXT3_t eScreen_EPD_EXT3, uint16_t slots)
+    {
+        return (panelDescriptor(eScreen_EPD_EXT3).codeSizeType == 0x0000) ? 0 :
+               (uint32_t)((panelDescriptor(eScreen_EPD_EXT3).sizeV + FLUSH_TILE_SIZE - 1) / FLUSH_TILE_SIZE) *
+               ((panelDescriptor(eScreen_EPD_EXT3).sizeH + FLUSH_TILE_SIZE - 1) / FLUSH_TILE_SIZE) * sizeof(flushTile_s) +
+               alignof(flushTile_s) - 1 + (uint32_t)slots * FLUSH_TILE_BYTES;
+    }
+
+    ///
+    /// @brief Get the tile pool, tiled mode
+    /// @return slots used and peak RAM against the frame-buffer with two pages, see tilePool_s
+    ///
+    tilePool_s getTilePool();
+
+    ///
+    /// @brief Initialisation with the frame-buffer in a storage
+    /// @details The frame-buffer with two pages is kept in the storage, eg. PSRAM or external SPI SRAM or FRAM
+    /// @n Drawing works on a write-back cache of rows in MCU internal SRAM,
+    /// the storage sees block reads and writes of one row only
+    /// @param storage initialised storage, at least frameBufferSize() bytes
+    /// @param cacheBuffer caller-owned memory in MCU internal SRAM, for the row cache
+    /// @param size bytes, at least two rows, see rowCacheSize()
+    /// @return true if success, false if storage or size too small
+    /// @note Rows modified are written back when evicted, least recently used first
+    /// @warning Screen cache is not available
+    /// @warning begin() initialises SPI and I2C
+    ///
+    /// @code {.cpp}
+    /// hV_Storage myStorage;
+    /// uint8_t cacheBuffer[Screen_EPD_EXT3_Fast::rowCacheSize(eScreen_EPD_EXT3_417_0D_Fast, 16)];
+    /// myStorage.begin(STORAGE_SPI_SRAM, Screen_EPD_EXT3_Fast::frameBufferSize(eScreen_EPD_EXT3_417_0D_Fast), 7);
+    /// myScreen.beginStorage(&myStorage, cacheBuffer, sizeof(cacheBuffer));
+    /// @endcode
+    ///
+    bool beginStorage(hV_Storage * storage, uint8_t * cacheBuffer, uint32_t size);
+
+    ///
+    /// @brief Size of the row cache for beginStorage()
+    /// @param eScreen_EPD_EXT3 size and model of the e-screen
+    /// @param rows rows of the row cache, at least 2
+    /// @return bytes, 0 if the screen is not supported
+    ///
+    static constexpr uint32_t rowCacheSize(eScreen_EPD_EXT3_t eScreen_EPD_EXT3, uint16_t rows)
+    {
+        return (panelDescriptor(eScreen_EPD_EXT3).codeSizeType == 0x0000) ? 0 :
+               alignof(flushLine_s) - 1 + (uint32_t)rows * (sizeof(flushLine_s) + panelDescriptor(eScreen_EPD_EXT3).sizeH / 8);
+    }
+
+    ///
+    /// @brief Get the row cache, storage mode
+    /// @return hits, misses and write-backs, see rowCache_s
+    /// @note Accesses to the storage, see hV_Storage::getStatistics()
+    ///
+    rowCache_s getRowCache();
+
+    ///
+    /// @brief Get the display list, banded mode
+    /// @return sizes and rasterisation time, see displayList_s
+    ///
+    displayList_s getDisplayList();
+
+    /// @cond
+    // Drawing, recorded in banded mode, see hV_Screen_Buffer
+    void circle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t colour);
+    void line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour);
+    void triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t colour);
+    void rectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour);
+    void point(uint16_t x1, uint16_t y1, uint16_t colour);
+    void gText(uint16_t x0, uint16_t y0,
+               String text,
+               uint16_t textColour = myColours.black,
+               uint16_t backColour = myColours.white);
+    /// @endcond
+
+    ///
+    /// @brief Set the compression of the previous frame, single page only
+    /// @details The displayed frame is compressed with run-length encoding after each upload,
+    /// into the space after the page, and decompressed row by row during the next upload
+    /// @n Rows are no longer saved before their first write
+    /// @param compression true = compressed, false = saved rows
+    /// @return true if success, false if not in single page mode
+    /// @note Effective from the next update
+    /// @note Saved rows are used instead for an image too large for the space
+    /// @see begin(uint8_t *, uint32_t)
+    ///
+    bool setFlushCompression(bool compression);
+
+    ///
+    /// @brief Get the compression of the previous frame
+    /// @return compression ratio and CPU cost, see flushCompression_s
+    ///
+    flushCompression_s getFlushCompression();
+
     ///
     /// @brief Who Am I
     /// @return Who Am I string
@@ -136,6 +749,135 @@ class Screen_EPD_EXT3_Fast final : public hV_Screen_Buffer, public hV_Utilities_
     ///
     void clear(uint16_t colour = myColours.white);
 
+    ///
+    /// @brief Scroll the screen
+    /// @details Whole rows of the frame-buffer moved, or bits within the rows,
+    /// depending on the orientation
+    /// @param dx shift, x-axis, positive to the right
+    /// @param dy shift, y-axis, positive to the bottom
+    /// @param fill colour of the uncovered area, default = white
+    /// @return true if success, false in banded or tiled mode
+    /// @note Moved rows are marked as drawn, unchanged rows are skipped at the next update
+    ///
+    bool scroll(int16_t dx, int16_t dy, uint16_t fill = myColours.white);
+
+    /// @name Surfaces
+    /// @{
+
+    ///
+    /// @brief Set the arena for the offscreen surfaces
+    /// @param arena buffer provided by the caller, no heap
+    /// @param size bytes, see surfaceSize()
+    /// @return true if success
+    /// @note All surfaces previously allocated are released
+    ///
+    bool setSurfaceArena(uint8_t * arena, uint32_t size);
+
+    ///
+    /// @brief Size of a surface in the arena
+    /// @param sizeX size, x-axis
+    /// @param sizeY size, y-axis
+    /// @return bytes, for any orientation
+    ///
+    static constexpr uint32_t surfaceSize(uint16_t sizeX, uint16_t sizeY)
+    {
+        return alignof(surface_s) - 1 + sizeof(surface_s) +
+               (((uint32_t)sizeY * ((sizeX + 7) / 8) > (uint32_t)sizeX * ((sizeY + 7) / 8)) ?
+                (uint32_t)sizeY * ((sizeX + 7) / 8) : (uint32_t)sizeX * ((sizeY + 7) / 8));
+    }
+
+    ///
+    /// @brief Allocate a surface from the arena
+    /// @param sizeX size, x-axis
+    /// @param sizeY size, y-axis
+    /// @param layout SURFACE_LAYOUT_PANEL, SURFACE_LAYOUT_TRANSPOSED, SURFACE_LAYOUT_ROWS, default = SURFACE_LAYOUT_PANEL
+    /// @return surface cleared to white, 0 if the arena is full
+    /// @note Sizes in the current orientation, to be used with the same orientation
+    /// @note Transposed surfaces are for layers only, with consecutive points along the x-axis
+    /// in the same byte for orientations 1 and 3, converted into panel order at flush by transpose8x8()
+    ///
+    surface_s * newSurface(uint16_t sizeX, uint16_t sizeY, uint8_t layout = SURFACE_LAYOUT_PANEL);
+
+    ///
+    /// @brief Release a surface
+    /// @param surface surface to release, with all the surfaces allocated after it
+    /// @note Last allocated first released, as a stack
+    ///
+    void releaseSurface(surface_s * surface);
+
+    ///
+    /// @brief Copy a rectangle between surfaces and the screen
+    /// @param target surface, 0 = screen
+    /// @param x target point, x-axis
+    /// @param y target point, y-axis
+    /// @param source surface, 0 = screen
+    /// @param x0 source point, x-axis
+    /// @param y0 source point, y-axis
+    /// @param dx size, x-axis
+    /// @param dy size, y-axis
+    /// @return true if success, false if outside the source or the target,
+    /// if source and target are the same, for transposed surfaces, or for the screen in banded or tiled mode
+    /// @note Whole bytes copied when source and target columns are aligned
+    ///
+    bool copyRect(surface_s * target, uint16_t x, uint16_t y, surface_s * source, uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy);
+
+    ///
+    /// @brief Save an area of the screen into a new surface
+    /// @param x0 point, x-axis
+    /// @param y0 point, y-axis
+    /// @param dx size, x-axis
+    /// @param dy size, y-axis
+    /// @return surface with the area and its position, 0 if failed
+    /// @note Restore with restoreRect(), then release with releaseSurface()
+    ///
+    surface_s * saveRect(uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy);
+
+    ///
+    /// @brief Restore an area of the screen saved with saveRect()
+    /// @param surface surface from saveRect()
+    /// @return true if success
+    /// @note Restored rows identical to the displayed ones are skipped at the next update
+    ///
+    bool restoreRect(surface_s * surface);
+
+    ///
+    /// @brief Get the surface arena
+    /// @return size, used and peak, see surfaceArena_s
+    ///
+    surfaceArena_s getSurfaceArena();
+
+    /// @}
+
+    /// @name Layers
+    /// @{
+
+    ///
+    /// @brief Set a layer
+    /// @details Layers are composited from white in increasing order, with their blend operation and mask,
+    /// into the next frame-buffer at flush, one word at a time
+    /// @param layer 0..FLUSH_LAYERS - 1
+    /// @param surface full screen surface, newSurface(screenSizeX(), screenSizeY()), 0 = layer removed
+    /// @param operation LAYER_REPLACE, LAYER_OR, LAYER_AND, LAYER_XOR, default = LAYER_OR, LAYER_NONE = layer removed
+    /// @param mask full screen surface, bits set where the layer applies, default = 0 = whole layer
+    /// @return true if success, false if the surfaces are not full screen, if the mask and the surface
+    /// have different layouts, in banded or tiled mode, or for transposed surfaces in storage mode
+    /// @note Transposed surfaces are converted by blocks of 8x8 points, 8 rows at a time
+    /// @note Rows drawn into layers since the last flush are rebuilt from the layers,
+    /// replacing the content of the frame-buffer
+    /// @note Call setLayer() again after writing into the data of the surface directly
+    ///
+    bool setLayer(uint8_t layer, surface_s * surface, uint8_t operation = LAYER_OR, surface_s * mask = 0);
+
+    ///
+    /// @brief Select the layer for drawing
+    /// @param layer 0..FLUSH_LAYERS - 1, default = LAYER_SCREEN = frame-buffer
+    /// @return true if success, false if the layer is not set
+    /// @note clear() on a layer is one memset
+    ///
+    bool selectLayer(uint8_t layer = LAYER_SCREEN);
+
+    /// @}
+
     ///
     /// @brief Update the display, fast update
     /// @note Display next frame-buffer on screen and copy next frame-buffer into old frame-buffer
@@ -145,31 +887,292 @@ class Screen_EPD_EXT3_Fast final : public hV_Screen_Buffer, public hV_Utilities_
     ///
     /// @brief Regenerate the panel
     /// @details White-to-black-to-white cycle to reduce ghosting
+    /// @note Same sequence as regenerate_nonBlocking()
     ///
     void regenerate();
 
+    ///
+    /// @brief Initiate a regeneration of the panel without blocking the CPU
+    /// @details White-to-black-to-white cycle to reduce ghosting
+    /// @note Requires the flush_task() method to be called regularly
+    /// @warning The frame-buffer is cleared: draw only once isBusy() returns false
+    ///
+    void regenerate_nonBlocking();
+
+    ///
+    /// @brief Set the automatic regeneration
+    /// @details The ghosting score of a region accumulates the pixels toggled by fast updates
+    /// @n When the worst region reaches the threshold, a black-to-white cycle of this region only is run in idle time
+    /// @param threshold ghosting score in %, 0 = off, eg. 1000 = each pixel toggled 10 times on average
+    /// @param idle time without update before the cycle starts, ms, default = 1000
+    /// @note Requires the flush_task() method to be called regularly
+    /// @note The cycle sends the displayed image with the region forced black then white, and leaves the frame-buffer unchanged
+    /// @note A global update resets the scores of all regions
+    ///
+    void setRegeneration(uint16_t threshold, uint32_t idle = 1000);
+
+    ///
+    /// @brief Get the ghosting score of a region
+    /// @param region 0..FLUSH_REGIONS - 1
+    /// @return toggles per pixel in %, 0 if out of range
+    ///
+    uint16_t getGhosting(uint8_t region);
+
+    ///
+    /// @brief Get the number of bytes changed by the last upload
+    /// @return bytes of the next frame different from the previous frame
+    /// @note Rows not drawn since the previous upload are not compared
+    ///
+    uint32_t getFlushChangedBytes();
+
+    ///
+    /// @brief Set the screen cache
+    /// @details Rendered screens are saved and restored with one copy, instead of drawing again
+    /// @param slots number of screens, each of one page of the frame-buffer
+    /// @return true if success
+    /// @note Call after begin(), once
+    /// @note Slots in PSRAM if available, in RAM otherwise
+    ///
+    bool setScreenCache(uint8_t slots);
+
+    ///
+    /// @brief Get the content hash of the frame-buffer
+    /// @return hash, never 0
+    /// @note Banded mode, hash of the display list
+    ///
+    uint32_t getScreenHash();
+
+    ///
+    /// @brief Save the frame-buffer into the screen cache
+    /// @param key application key, default = 0 = content hash
+    /// @return key of the saved screen, 0 = no cache
+    /// @note Replaces the screen with the same key, otherwise an empty or the least recently used slot
+    ///
+    uint32_t saveScreenCache(uint32_t key = 0);
+
+    ///
+    /// @brief Load a screen from the screen cache into the frame-buffer
+    /// @param key application key or content hash returned by saveScreenCache()
+    /// @return true if found, false if not in cache
+    /// @note The frame-buffer is then displayed with flush()
+    ///
+    bool loadScreenCache(uint32_t key);
+
     ///
     /// @brief Update the display
     /// @details Display next frame-buffer on screen and copy next frame-buffer into old frame-buffer
     /// @param updateMode expected update mode
     /// @return uint8_t recommended mode
     /// @note Mode checked with checkTemperatureMode()
+    /// @note Fast update returns immediately when nothing has been drawn since the last update
     ///
     uint8_t flushMode(uint8_t updateMode = UPDATE_FAST);
 
     ///
     /// @brief Initiate a display update without blocking the CPU until the screen update is complete
     /// @details Display next frame-buffer on screen and copy next frame-buffer into old frame-buffer
+    /// @param deadline time by which the update should be visible, ms as per millis(), default = 0 = none
     /// @note Requires the flush_task() method to be called regularly to continue the update operation
+    /// @note Requests received during an update are coalesced according to setFlushPolicy()
+    ///
+    void flush_nonBlocking(uint32_t deadline = 0);
+
     ///
-    void flush_nonBlocking();
+    /// @brief Initiate a display update with mode without blocking the CPU
+    /// @details Display next frame-buffer on screen and copy next frame-buffer into old frame-buffer
+    /// @param updateMode expected update mode, UPDATE_FAST or UPDATE_GLOBAL
+    /// @param deadline time by which the update should be visible, ms as per millis(), default = 0 = none
+    /// @note Mode checked with checkTemperatureMode() when the update starts
+    /// @note A global request merged with fast requests makes the update global
+    ///
+    void flushMode_nonBlocking(uint8_t updateMode, uint32_t deadline = 0);
 
     ///
     /// @brief Continue a display update that was initiated with flush_nonBlocking()
     /// @note This function must be called regularly in applications that use flush_nonBlocking()
+    /// @note A request held by the pacing policy is started by flush_task()
     ///
     void flush_task();
 
+    ///
+    /// @brief Set the pacing policy for non-blocking update
+    /// @param policy pacing policy, default = FLUSH_POLICY_LATEST
+    /// * FLUSH_POLICY_LATEST: latest request wins, started interval ms after the previous update completion
+    /// * FLUSH_POLICY_RATE: latest request wins, started interval ms after the previous update start
+    /// * FLUSH_POLICY_DEADLINE: started as late as possible to meet the earliest pending deadline
+    /// @param interval minimum interval in ms, or default latency for requests without deadline, default = 0
+    /// @note Use FLUSH_POLICY_DEADLINE with deadlines to merge as many requests as possible into one update
+    /// @note With FLUSH_POLICY_DEADLINE, the first update starts immediately, as no duration is yet known
+    ///
+    void setFlushPolicy(uint8_t policy = FLUSH_POLICY_LATEST, uint32_t interval = 0);
+
+    ///
+    /// @brief Get the statistics for non-blocking update
+    /// @return statistics, see flushStatistics_s
+    ///
+    flushStatistics_s getFlushStatistics();
+
+    ///
+    /// @brief Reset the statistics for non-blocking update
+    ///
+    void resetFlushStatistics();
+
+    ///
+    /// @brief Get the metrics of one stage of the update
+    /// @param stage FLUSH_STAGE_INITIAL, FLUSH_STAGE_SEND, FLUSH_STAGE_UPDATE or FLUSH_STAGE_POWEROFF
+    /// @param updateMode UPDATE_FAST or UPDATE_GLOBAL, default = UPDATE_FAST
+    /// @param band FLUSH_BAND_COLD, FLUSH_BAND_NOMINAL or FLUSH_BAND_HOT, default = FLUSH_BAND_NOMINAL
+    /// @return metrics, see flushMetrics_s, empty if out of range
+    /// @note Measured for both blocking and non-blocking updates, with temperature band at start
+    ///
+    flushMetrics_s getFlushMetrics(uint8_t stage, uint8_t updateMode = UPDATE_FAST, uint8_t band = FLUSH_BAND_NOMINAL);
+
+    ///
+    /// @brief Predict the mode of the next update
+    /// @param updateMode expected update mode, default = UPDATE_FAST
+    /// @return mode used by the next update, as per the temperature governor
+    /// @see setTemperatureGovernor()
+    ///
+    uint8_t getFlushPredictedMode(uint8_t updateMode = UPDATE_FAST);
+
+    ///
+    /// @brief Predict the cost of the next update
+    /// @param updateMode expected update mode, default = UPDATE_FAST
+    /// @return mean duration from start to visible in ms, for the predicted mode and the current temperature band,
+    /// 0 = not yet measured or no update
+    /// @note Use to defer non-urgent updates when a global update is predicted
+    ///
+    uint32_t getFlushPredictedCost(uint8_t updateMode = UPDATE_FAST);
+
+    ///
+    /// @brief Reset the metrics of all stages, modes and bands
+    ///
+    void resetFlushMetrics();
+
+    ///
+    /// @brief Stages of the update
+    /// @details Blocking and non-blocking updates share the same sequence
+    ///
+    enum FlushState
+    {
+        kReady = 0, ///< No update in progress
+        kCOGInitial, ///< Soft-reset in progress, then settings
+        kCOGSend, ///< Frame-buffer upload in progress
+        kCOGUpdate, ///< Frame-buffer uploaded, power-on in progress
+        kCOGRefresh, ///< Refresh in progress
+        kCOGPowerOff ///< Refresh completed and visible, power-off in progress
+    };
+
+    ///
+    /// @brief Get the current stage of the non-blocking update
+    /// @return stage, see FlushState
+    ///
+    FlushState getFlushState();
+
+    ///
+    /// @brief Check whether an update or a regeneration is in progress or pending
+    /// @return true if busy, false if ready
+    ///
+    bool isBusy();
+
+    ///
+    /// @brief Get the duration of the last completed non-blocking update
+    /// @return duration in ms
+    ///
+    uint32_t getFlushDuration();
+
+    ///
+    /// @brief Get the time of the last transition to a stage
+    /// @param state stage, see FlushState
+    /// @return timestamp in µs as per micros(), 0 if state is out of range
+    /// @note kReady records the end of the last update
+    /// @note Stages, timestamps and callbacks cover both flush() and flush_nonBlocking()
+    ///
+    uint32_t getFlushTimestamp(FlushState state);
+
+    ///
+    /// @brief Get the time the last update became visible
+    /// @return timestamp in µs as per micros()
+    ///
+    uint32_t getFlushVisibleTimestamp();
+
+    ///
+    /// @brief Set the callbacks for non-blocking update
+    /// @param uploaded called when the frame-buffer is sent and free to modify, default = none
+    /// @param visible called when the refresh is completed and the new image visible, default = none
+    /// @note Callbacks are called from flush() or flush_task() after the stage change, and should return quickly
+    ///
+    void setFlushCallbacks(flushCallback_t uploaded = 0, flushCallback_t visible = 0);
+
+#if defined(__cpp_impl_coroutine)
+    ///
+    /// @brief Awaitable update for C++20 coroutines
+    /// @note Resumed by flush_task() when the awaited update is completed
+    ///
+    struct flushAwaiter
+    {
+        Screen_EPD_EXT3_Fast * screen; ///< screen to wait for
+        uint32_t sequence; ///< update to wait for
+
+        /// @cond
+        bool await_ready()
+        {
+            return ((int32_t)(screen->flushCompleted - sequence) >= 0);
+        }
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            return screen->flush_suspend(handle, sequence);
+        }
+        bool await_resume()
+        {
+            return ((int32_t)(screen->flushCompleted - sequence) >= 0);
+        }
+        /// @endcond
+    };
+
+    ///
+    /// @brief Initiate a display update and wait for completion from a coroutine
+    /// @param deadline time by which the update should be visible, ms as per millis(), default = 0 = none
+    /// @return awaitable, co_await returns true when the update is completed, false if rejected
+    /// @note Requires the flush_task() method to be called regularly, but not from the awaiting coroutine
+    /// @note Up to FLUSH_AWAITERS coroutines wait at the same time, others are rejected
+    ///
+    flushAwaiter flush_await(uint32_t deadline = 0);
+#endif // __cpp_impl_coroutine
+
+#if (WORKER_MODE != USE_WORKER_NONE)
+    ///
+    /// @brief Start the worker driving the display
+    /// @return true if started
+    /// @note After begin(). The worker owns SPI and busy pin: do not call flush(), flush_nonBlocking() or flush_task() until flush_endWorker()
+    /// @note Callbacks are called from the worker
+    ///
+    bool flush_beginWorker();
+
+    ///
+    /// @brief Stop the worker
+    /// @note The update in progress, if any, is completed by the worker before it stops
+    ///
+    void flush_endWorker();
+
+    ///
+    /// @brief Post a request to the worker
+    /// @param deadline time by which the update should be visible, ms as per millis(), default = 0 = none
+    /// @return ticket for flush_waitPosted(), 0 if the queue is full
+    /// @note Lock-free, single producer: post from one task only
+    ///
+    uint32_t flush_post(uint32_t deadline = 0);
+
+    ///
+    /// @brief Wait for a posted request to be displayed
+    /// @param ticket as returned by flush_post()
+    /// @param timeout in ms
+    /// @return true if displayed, false if timed out
+    /// @note FreeRTOS: one waiting task at a time, woken by task notification
+    ///
+    bool flush_waitPosted(uint32_t ticket, uint32_t timeout);
+#endif // WORKER_MODE
+
   protected:
     /// @cond
 
@@ -200,17 +1203,54 @@ class Screen_EPD_EXT3_Fast final : public hV_Screen_Buffer, public hV_Utilities_
     /// @brief Get point
     /// @param x1 x coordinate
     /// @param y1 y coordinate
-    /// @return colour 16-bit colour
+    /// @return colour 16-bit colour, as drawn before inversion
     /// @n @b More: @ref Colour, @ref Coordinate
     ///
     uint16_t _getPoint(uint16_t x1, uint16_t y1);
 
+    // Pixel paths specialised by orientation, selected by _setOrientation()
+    template <uint8_t orientation> bool _orientPoint(uint16_t & x, uint16_t & y);
+    template <uint8_t orientation> void _setPointOriented(uint16_t x1, uint16_t y1, uint16_t colour);
+    template <uint8_t orientation> uint16_t _getPointOriented(uint16_t x1, uint16_t y1);
+    template <uint8_t orientation> void _setPointBanded(uint16_t x1, uint16_t y1, uint16_t colour);
+    template <uint8_t orientation> uint16_t _getPointBanded(uint16_t x1, uint16_t y1);
+    template <uint8_t orientation> void _setPointStored(uint16_t x1, uint16_t y1, uint16_t colour);
+    template <uint8_t orientation> void _setPointTiled(uint16_t x1, uint16_t y1, uint16_t colour);
+    template <uint8_t orientation> uint16_t _getPointTiled(uint16_t x1, uint16_t y1);
+    template <uint8_t orientation, bool transposed> void _setPointLayer(uint16_t x1, uint16_t y1, uint16_t colour);
+    template <uint8_t orientation, bool transposed> uint16_t _getPointLayer(uint16_t x1, uint16_t y1);
+    void (Screen_EPD_EXT3_Fast::*pointWriter)(uint16_t x1, uint16_t y1, uint16_t colour);
+    uint16_t (Screen_EPD_EXT3_Fast::*pointReader)(uint16_t x1, uint16_t y1);
+
+    // Spans, whole bytes instead of single pixels
+    void _setSpanH(uint16_t x1, uint16_t x2, uint16_t y1, uint16_t colour);
+    void _setSpanV(uint16_t x1, uint16_t y1, uint16_t y2, uint16_t colour);
+    void _setRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour);
+    void _fillRow(uint16_t row, uint16_t first, uint16_t last);
+    void _fillBytes(uint8_t * data, uint16_t row, uint16_t first, uint16_t last);
+    void _fillBits(uint16_t row, uint8_t & setBits, uint8_t & clearBits);
+    void _fillTiles(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+    void _clearRow(uint8_t * data, uint16_t row, uint16_t colour);
+    void _shiftRow(uint8_t * data, uint16_t row, int16_t shift);
+
+    // Surfaces, physical rectangles, 0 = screen
+    bool _orientRect(uint16_t & x, uint16_t & y, uint16_t dx, uint16_t dy, uint16_t rows, uint16_t columns);
+    void _copyRows(surface_s * target, uint16_t row, uint16_t column, surface_s * source, uint16_t sourceRow, uint16_t sourceColumn, uint16_t rows, uint16_t columns);
+    void _copyBits(uint8_t * target, uint16_t first, const uint8_t * source, uint16_t start, uint16_t count);
+
+    // Colour resolved once for consecutive points of the same colour
+    // Inversion applied when sent, not when drawn
+    void _resolveColour(uint16_t colour);
+    uint16_t pointColour;
+    uint8_t pointOperation[2]; // by parity of row + column, POINT_NONE, POINT_CLEAR or POINT_SET
+
     // Position
     ///
     /// @brief Convert
     /// @param x1 x-axis coordinate
     /// @param y1 y-axis coordinate
     /// @return index for u_newImage[]
+    /// @note Row of the next page, copied from the previous page if outdated
     ///
     uint32_t _getZ(uint16_t x1, uint16_t y1);
 
@@ -231,35 +1271,205 @@ class Screen_EPD_EXT3_Fast final : public hV_Screen_Buffer, public hV_Utilities_
     //
 
     // * Other functions specific to the screen
+    void COG_reset();
     void COG_initial(uint8_t updateMode);
-    void COG_getUserData();
     void COG_sendImageDataFast();
+    void COG_sendImageDataRegion();
     void COG_update(uint8_t updateMode);
+    void COG_refresh();
     void COG_powerOff();
 
     // * Flush
-    void _flushFast();
+    void _flush(uint8_t updateMode);
 
-    bool _flag50;
-    bool _flag152;
+    panelDescriptor_s _panel;
 
     // * Non-blocking Flush
-    void flush_sendImageAndStartUpdate();
-
-    enum FlushState
-    {
-        kReady = 0,
-        kCOGInitial_1,
-        kCOGInitial_2,
-        kCOGUpdate_1,
-        kCOGUpdate_2,
-        kCOGPowerOff_1,
-        kCOGPowerOff_2
-    };
+    void flush_resume();
+    void flush_start(uint8_t updateMode);
+    void flush_complete();
+    void flush_schedule();
+    void flush_visible();
+    void flush_setState(FlushState state);
+    void flush_wait(FlushState state);
+    void flush_regenerate();
+    void flush_maintain();
+    void flush_measure(flushMetrics_s & metrics, uint32_t duration);
+    uint8_t flush_band();
+    void flush_scanRows();
+    void flush_sendRows(uint8_t index, uint8_t page, uint16_t fillFirst = 0, uint16_t fillLast = 0, uint8_t fill = 0x00);
+    uint8_t * flush_row(uint16_t row, uint8_t page, uint8_t access = FLUSH_ACCESS_READ);
+    uint8_t * flush_previousRow(uint16_t row);
+    void flush_compress();
+    void flush_decodeRow(uint8_t * data);
+    void flush_touchRow(uint16_t row, bool whole = false);
+    uint16_t flush_hashRow(const uint8_t * data);
 
     bool flushPending;
+    uint8_t flushPendingMode; // UPDATE_GLOBAL prevails
+    uint8_t flushRegenerate; // 0 = none, 1 = black, 2 = white
+    uint32_t flushRegenerateSequence;
     FlushState flushState;
     bool nextBusyPinState;
+
+    // Pacing
+    uint8_t flushPolicy;
+    uint32_t flushInterval; // ms
+    uint32_t flushDeadline; // ms, pending requests, 0 = none
+    uint32_t flushTarget; // ms, pending requests, deadline or default latency
+    uint32_t flushCurrentDeadline; // ms, update in progress, 0 = none
+    bool flushUploaded; // update in progress has sent the frame-buffer
+    uint32_t flushStartTime, flushVisibleTime, flushEndTime, flushDuration; // ms
+    uint32_t flushLatency; // ms, from start to visible, 0 = not yet measured
+    flushStatistics_s flushStatistics;
+
+    // Status
+    uint32_t flushTimestamps[kCOGPowerOff + 1]; // µs
+    uint32_t flushVisibleTimestamp; // µs
+    flushCallback_t flushUploadedCallback;
+    flushCallback_t flushVisibleCallback;
+    uint8_t flushUpdateMode;
+
+    // Metrics, by stage, mode global or fast, and temperature band
+    flushMetrics_s flushMetrics[FLUSH_STAGES][2][FLUSH_BANDS];
+    uint8_t flushBand;
+
+    // Ghosting, toggled pixels by region
+    uint32_t flushToggles[FLUSH_REGIONS];
+    uint16_t flushGhostingThreshold; // %, 0 = off
+    uint32_t flushGhostingIdle; // ms
+    uint8_t flushMaintenance; // 0 = none, 1 = black, 2 = white, 3 = restore
+    uint8_t flushMaintenanceRegion;
+    uint32_t flushMaintenanceSequence;
+
+    // Inversion of the displayed frame, XOR-ed when the previous frame is sent
+    bool flushInvertPrevious;
+
+    // Rows, metadata by row of the frame-buffer
+    flushRow_s * flushRows;
+    bool flushDirty; // at least one row drawn since last upload
+    uint32_t flushChangedBytes;
+
+    // Single page, previous rows saved with row number, 2 + u_bufferSizeH bytes each
+    bool flushSinglePage;
+    uint8_t * flushScratch; // one row, previous row rebuilt
+    uint8_t * flushSaved;
+    uint16_t flushSavedSlots;
+    uint16_t flushSavedCount;
+    uint16_t flushLost; // rows without previous row since last upload
+    uint32_t flushPoolSize; // bytes after the page and scratch row
+
+    // Single page, previous frame compressed instead of saved rows, non-uniform rows only
+    bool flushCompression; // option, from next upload
+    bool flushCompressed; // previous frame compressed
+    uint16_t flushCursorRow; // next row to decode, rows read in increasing order
+    uint32_t flushCursorOffset;
+    flushCompression_s flushCompressionInfo;
+
+    // Banded mode, display list instead of frame-buffer
+    // Displayed frame = [0, listDisplayed), next frame = [listStart, listUsed)
+    uint8_t * flush_record(uint8_t command, uint16_t size, int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+    void flush_replay(uint32_t start, uint32_t end);
+    void flush_rasterise(uint16_t first, uint16_t last, uint32_t start, uint32_t end);
+    void flush_sendBands(uint8_t index, uint32_t start, uint32_t end, uint8_t mask);
+    uint8_t * bandBuffer;
+    uint16_t bandRows; // 0 = frame-buffer
+    uint16_t bandFirst, bandLast; // rows rasterised, last excluded
+    bool bandReplaying;
+    uint8_t * listData;
+    uint32_t listSize, listUsed, listStart, listDisplayed;
+    uint32_t listDropped, listRasterTime;
+
+    // Tiled mode, tile map and tile pool instead of frame-buffer
+    // Free slots chained by slot number, in the first two bytes of the slot
+    uint8_t * flush_touchTile(uint16_t index);
+    void flush_setTile(uint16_t index, uint8_t value);
+    uint8_t flush_tileByte(const flushTile_s & tile, uint8_t page, uint16_t offset);
+    uint16_t flush_allocateTile();
+    void flush_releaseTile(uint16_t slot);
+    uint16_t flush_collapseTiles();
+    void flush_sendTiles(uint8_t index, uint8_t page, uint8_t mask);
+    void flush_uploadTiles(uint8_t indexPrevious, uint8_t indexNext);
+    bool flushTiled;
+    flushTile_s * flushTiles;
+    uint8_t * tilePool;
+    uint16_t tilesH, tilesV; // tiles by row and by column
+    uint16_t tileSlots, tileFree, tileUsed, tilePeak;
+    uint32_t tileDropped;
+
+    // Storage mode, frame-buffer in storage, rows in row cache
+    uint8_t * flush_cacheRow(uint32_t address, uint8_t access);
+    hV_Storage * flushStorage;
+    flushLine_s * rowLines;
+    uint8_t * rowData;
+    uint16_t rowLineCount;
+    uint16_t rowLast; // most recently used line
+    uint32_t rowClock; // LRU
+    bool flushSending; // panel selected, released for external storage
+    rowCache_s rowCache;
+
+    // Surface arena, last allocated first released
+    uint8_t * surfaceArena;
+    uint32_t surfaceArenaSize, surfaceUsed, surfacePeak;
+
+    // Layers, composited into the next frame-buffer at flush
+    void flush_composeLayers();
+    template <uint8_t operation> void flush_blendLayer(uint8_t * data, const uint8_t * layer, const uint8_t * mask);
+    template <uint8_t operation> void flush_blendRows(uint8_t ** rows, uint8_t count, uint16_t first, const flushLayer_s & layer);
+    flushLayer_s flushLayers[FLUSH_LAYERS];
+    surface_s * layerTarget; // drawing target, 0 = frame-buffer
+    uint16_t layerFirst, layerLast; // rows drawn into surfaces since last composition, none if first > last
+
+    // Screen cache
+    cacheSlot_s * cacheSlots;
+    uint8_t * cacheData;
+    uint8_t cacheSlotCount;
+    uint32_t cacheClock; // LRU
+
+    // Sequence numbers, updates started and completed
+    uint32_t flushSequence;
+    uint32_t flushCompleted;
+
+    uint32_t flush_target();
+
+#if defined(__cpp_impl_coroutine)
+    bool flush_suspend(std::coroutine_handle<> handle, uint32_t sequence);
+    std::coroutine_handle<> flushAwaiting[FLUSH_AWAITERS];
+    uint32_t flushAwaitingSequence[FLUSH_AWAITERS];
+#endif // __cpp_impl_coroutine
+
+#if (WORKER_MODE != USE_WORKER_NONE)
+    // Worker
+    void flush_work();
+    bool flush_pop(flushRequest_s & request);
+    void flush_serve(uint32_t ticket);
+    bool flush_idle();
+
+    // Bounded single-producer single-consumer queue
+    flushRequest_s flushQueue[FLUSH_QUEUE_SIZE];
+    std::atomic<uint8_t> flushQueueHead; // written by worker
+    std::atomic<uint8_t> flushQueueTail; // written by producer
+    uint32_t flushPosted; // last ticket, producer only
+    std::atomic<uint32_t> flushServed; // last ticket displayed
+    std::atomic<bool> flushWorkerRunning;
+
+    // Tickets waiting for the update in progress or the next one, by parity of the sequence number
+    uint32_t flushTickets[2];
+    uint32_t flushTicketSequences[2];
+
+#if (WORKER_MODE == USE_WORKER_THREAD)
+    std::thread flushWorkerThread;
+    std::mutex flushWorkerMutex;
+    std::condition_variable flushWorkerWake; // posted request
+    std::condition_variable flushWorkerServed; // displayed request
+
+#elif (WORKER_MODE == USE_WORKER_FREERTOS)
+    static void flush_worker(void * parameters);
+    static void flush_busyISR();
+    TaskHandle_t flushWorkerHandle;
+    TaskHandle_t flushWaiterHandle;
+#endif // WORKER_MODE
+#endif // WORKER_MODE
     // Work settings
     uint8_t index50b_work[1]; // Vcom
     uint8_t indexE0_work[1]; // Activate temperature
@@ -277,5 +1487,57 @@ class Screen_EPD_EXT3_Fast final : public hV_Screen_Buffer, public hV_Utilities_
     /// @endcond
 };
 
+///
+/// @brief Class for Pervasive Displays iTC monochrome screens with embedded fast update, static frame-buffer
+/// @details Screen selected at compile time, sizes from the panel descriptor
+/// * frame-buffer and row metadata allocated with the object, no heap
+/// * RAM reported at link time for a global object
+/// @tparam screen size and type, see hV_List_Screens.h
+///
+/// @code {.cpp}
+/// Screen_EPD_EXT3_Fast_Static<eScreen_EPD_EXT3_271_09_Fast> myScreen(boardRaspberryPiPico_RP2040);
+/// @endcode
+///
+template <eScreen_EPD_EXT3_t screen>
+class Screen_EPD_EXT3_Fast_Static final : public Screen_EPD_EXT3_Fast
+{
+  public:
+    ///
+    /// @brief Panel descriptor, constant
+    ///
+    static constexpr panelDescriptor_s panel = panelDescriptor(screen);
+    static_assert(panel.codeSizeType != 0x0000, "Screen not supported");
+
+    ///
+    /// @brief Size of one page of the frame-buffer, bytes
+    ///
+    static constexpr uint32_t pageSize = (uint32_t)panel.sizeV * (panel.sizeH / 8);
+
+    ///
+    /// @brief Constructor
+    /// @param board board configuration
+    ///
+    Screen_EPD_EXT3_Fast_Static(pins_t board) : Screen_EPD_EXT3_Fast(screen, board)
+    {
+        // begin() uses the buffers already set
+        u_newImage = staticFrameBuffer;
+        flushRows = staticRows;
+    }
+
+  protected:
+    /// @cond
+    uint8_t staticFrameBuffer[pageSize * 2]; // next and previous pages
+    flushRow_s staticRows[panel.sizeV];
+    /// @endcond
+};
+
+/// @cond
+template <eScreen_EPD_EXT3_t screen>
+constexpr panelDescriptor_s Screen_EPD_EXT3_Fast_Static<screen>::panel;
+
+template <eScreen_EPD_EXT3_t screen>
+constexpr uint32_t Screen_EPD_EXT3_Fast_Static<screen>::pageSize;
+/// @endcond
+
 #endif // SCREEN_EPD_EXT3_RELEASE
 
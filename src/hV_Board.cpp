@@ -61,10 +61,19 @@ void hV_Board::b_resume()
 
 void hV_Board::b_sendIndexFixed(uint8_t index, uint8_t data, uint32_t size)
 {
-    // Not implemented
+    b_beginIndexData(index);
+    b_sendDataFixed(data, size);
+    b_endIndexData();
 }
 
 void hV_Board::b_sendIndexData(uint8_t index, const uint8_t * data, uint32_t size)
+{
+    b_beginIndexData(index);
+    b_sendData(data, size);
+    b_endIndexData();
+}
+
+void hV_Board::b_beginIndexData(uint8_t index)
 {
     digitalWrite(b_pin.panelDC, LOW); // DC Low
     digitalWrite(b_pin.panelCS, LOW); // CS Low
@@ -99,10 +108,26 @@ void hV_Board::b_sendIndexData(uint8_t index, const uint8_t * data, uint32_t siz
         }
     }
     delayMicroseconds(b_delayCS);
+}
+
+void hV_Board::b_sendData(const uint8_t * data, uint32_t size, uint8_t mask)
+{
     for (uint32_t i = 0; i < size; i++)
     {
-        SPI.transfer(data[i]);
+        SPI.transfer(data[i] ^ mask);
     }
+}
+
+void hV_Board::b_sendDataFixed(uint8_t data, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        SPI.transfer(data);
+    }
+}
+
+void hV_Board::b_endIndexData()
+{
     delayMicroseconds(b_delayCS);
     if (b_family == FAMILY_LARGE)
     {
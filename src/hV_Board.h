@@ -83,7 +83,6 @@ class hV_Board
     /// @param index register
     /// @param data data, one byte covers 8 pixels
     /// @param len number of bytes
-    /// @note Valid for all except large screens
     ///
     void b_sendIndexFixed(uint8_t index, uint8_t data, uint32_t len);
 
@@ -96,6 +95,35 @@ class hV_Board
     ///
     void b_sendIndexData(uint8_t index, const uint8_t * data, uint32_t size);
 
+    ///
+    /// @brief Start sending data through SPI in several parts
+    /// @param index register
+    /// @note Followed by b_sendData() or b_sendDataFixed(), and b_endIndexData()
+    ///
+    void b_beginIndexData(uint8_t index);
+
+    ///
+    /// @brief Send a part of data through SPI
+    /// @param data data
+    /// @param size number of bytes
+    /// @param mask XOR-ed to each byte, default = 0x00, 0xff to invert
+    /// @note Between b_beginIndexData() and b_endIndexData()
+    ///
+    void b_sendData(const uint8_t * data, uint32_t size, uint8_t mask = 0x00);
+
+    ///
+    /// @brief Send a fixed value through SPI
+    /// @param data data, one byte covers 8 pixels
+    /// @param size number of bytes
+    /// @note Between b_beginIndexData() and b_endIndexData()
+    ///
+    void b_sendDataFixed(uint8_t data, uint32_t size);
+
+    ///
+    /// @brief End sending data through SPI in several parts
+    ///
+    void b_endIndexData();
+
     ///
     /// @brief Send data through SPI to the two halves of large screens
     /// @param index register
@@ -0,0 +1,129 @@
+//
+// hV_Console.cpp
+// Library C++ code
+// ----------------------------------
+//
+// Project Pervasive Displays Library Suite
+// Based on highView technology
+//
+// Created by Rei Vilo, 21 Jan 2024
+//
+// Copyright (c) Rei Vilo, 2010-2023
+// Licence Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+//
+// See hV_Console.h for references
+//
+// Release 704: Added scrolling text console
+//
+
+// Library header
+#include "hV_Console.h"
+
+hV_Console::hV_Console()
+{
+    c_screen = 0; // nullptr
+    c_font = 0;
+    c_textColour = myColours.black;
+    c_backColour = myColours.white;
+    c_height = 0;
+    c_lines = 0;
+    c_line = 0;
+}
+
+bool hV_Console::begin(Screen_EPD_EXT3_Fast * screen, uint8_t font, uint16_t textColour, uint16_t backColour)
+{
+    if (screen == 0)
+    {
+        return false;
+    }
+
+    // Line height from the font
+    uint8_t previous = screen->getFont();
+    screen->selectFont(font);
+    uint16_t height = screen->characterSizeY();
+    screen->selectFont(previous);
+    if ((height == 0) or (height > screen->screenSizeY()))
+    {
+        return false;
+    }
+
+    c_screen = screen;
+    c_font = font;
+    c_textColour = textColour;
+    c_backColour = backColour;
+    c_height = height;
+    c_lines = screen->screenSizeY() / height;
+    c_line = 0;
+    return true;
+}
+
+void hV_Console::clear()
+{
+    if (c_screen == 0)
+    {
+        return;
+    }
+
+    c_screen->clear(c_backColour);
+    c_line = 0;
+}
+
+void hV_Console::println(String text)
+{
+    if (c_screen == 0)
+    {
+        return;
+    }
+
+    uint8_t previous = c_screen->getFont();
+    c_screen->selectFont(c_font);
+
+    // One line per new line character, wrapped to the width of the screen
+    do
+    {
+        int16_t end = text.indexOf('\n');
+        String line = (end < 0) ? text : text.substring(0, end);
+        text = (end < 0) ? "" : text.substring(end + 1);
+
+        do
+        {
+            uint16_t length = c_screen->stringLengthToFitX(line, c_screen->screenSizeX());
+            if (length == 0)
+            {
+                length = 1;
+            }
+            c_newLine(line.substring(0, length));
+            line = line.substring(length);
+        }
+        while (line.length() > 0);
+    }
+    while (text.length() > 0);
+
+    c_screen->selectFont(previous);
+}
+
+uint16_t hV_Console::getLines()
+{
+    return c_lines;
+}
+
+void hV_Console::c_newLine(String text)
+{
+    // Screen full, moved up by one line, or cleared if scroll is not available
+    if (c_line >= c_lines)
+    {
+        if (c_screen->scroll(0, -c_height, c_backColour))
+        {
+            c_line = c_lines - 1;
+        }
+        else
+        {
+            c_screen->clear(c_backColour);
+            c_line = 0;
+        }
+    }
+
+    // New line only, on an uncovered area
+    c_screen->gText(0, c_line * c_height, text, c_textColour, c_backColour);
+    c_line++;
+}
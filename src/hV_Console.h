@@ -0,0 +1,93 @@
+///
+/// @file hV_Console.h
+/// @brief Scrolling text console for log-style screens
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// * Edition: Basic
+///
+/// @author Rei Vilo
+/// @date 21 Jan 2024
+/// @version 704
+///
+/// @copyright (c) Rei Vilo, 2010-2023
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+///
+/// @see Screen_EPD_EXT3_Fast::scroll()
+///
+
+// SDK
+#include "hV_HAL_Peripherals.h"
+
+// Configuration
+#include "hV_Configuration.h"
+
+// Screen
+#include "Screen_EPD_EXT3.h"
+
+#ifndef hV_CONSOLE_RELEASE
+///
+/// @brief Library release number
+///
+#define hV_CONSOLE_RELEASE 704
+
+///
+/// @brief Class for the text console
+/// @details Lines appended at the bottom, the screen scrolled up by one line once full
+/// @n Only the new line is drawn, moved rows are detected as such at the next update
+///
+class hV_Console
+{
+  public:
+    ///
+    /// @brief Constructor
+    ///
+    hV_Console();
+
+    ///
+    /// @brief Initialisation
+    /// @param screen screen, initialised and oriented
+    /// @param font font number, default = 0
+    /// @param textColour 16-bit colour, default = black
+    /// @param backColour 16-bit colour, default = white
+    /// @return true if success, false if the font is higher than the screen
+    /// @note The console uses the whole screen with the orientation set before begin()
+    ///
+    bool begin(Screen_EPD_EXT3_Fast * screen, uint8_t font = 0, uint16_t textColour = myColours.black, uint16_t backColour = myColours.white);
+
+    ///
+    /// @brief Clear the console and the screen
+    ///
+    void clear();
+
+    ///
+    /// @brief Append a line
+    /// @param text text, split on new line characters and wrapped to the width of the screen
+    /// @note Call Screen_EPD_EXT3_Fast::flush() to update the screen
+    ///
+    void println(String text);
+
+    ///
+    /// @brief Number of lines on the screen
+    /// @return lines
+    ///
+    uint16_t getLines();
+
+    /// @cond
+  protected:
+
+    void c_newLine(String text);
+
+    Screen_EPD_EXT3_Fast * c_screen;
+    uint8_t c_font;
+    uint16_t c_textColour;
+    uint16_t c_backColour;
+    uint16_t c_height; // pixels per line
+    uint16_t c_lines; // lines on the screen
+    uint16_t c_line; // next line
+    /// @endcond
+};
+
+#endif // hV_CONSOLE_RELEASE
+
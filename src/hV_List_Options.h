@@ -15,6 +15,8 @@
 /// * 9. Set GPIO expander mode, not implemented
 /// * 10. String object for basic edition
 /// * 11. Set storage mode, not implemented
+/// * 12. Set worker mode for display flush
+/// * 13. Set transpose kernel for transposed layers
 ///
 /// @author Rei Vilo
 /// @date 21 Nov 2023
@@ -175,10 +177,35 @@
 /// @}
 
 ///
-/// @brief 12- Debug timing dump for display flush
+/// @brief 12- Set worker mode for display flush
+/// @details Dedicated task driving the display, fed by flush_post()
+/// * FreeRTOS: ESP32, RP2040 with FreeRTOS
+/// * Thread: Linux and other hosts with std::thread
+/// @note The worker owns SPI and busy pin, see flush_beginWorker()
 ///
 /// @{
-#define FLUSH_TIMING 0 ///< Set to 1 to dump flush() function timing info to serial port
+#define USE_WORKER_NONE 0 ///< No worker, flush_task() called by the application
+#define USE_WORKER_FREERTOS 1 ///< FreeRTOS task, woken by busy pin interrupt
+#define USE_WORKER_THREAD 2 ///< std::thread
+
+#define WORKER_MODE USE_WORKER_NONE ///< Selected option
+/// @}
+
+///
+/// @brief 13- Set transpose kernel for transposed layers
+/// @details 8x8 bit-matrix transpose, used at flush to convert transposed layers into panel order
+/// * Automatic: 64-bit on 64-bit MCU and host, 32-bit otherwise
+/// * SSE2 and NEON: host only, selected explicitly
+/// @see transpose8x8()
+///
+/// @{
+#define USE_TRANSPOSE_AUTO 0 ///< Best kernel for the target
+#define USE_TRANSPOSE_32 1 ///< Two 32-bit words, portable
+#define USE_TRANSPOSE_64 2 ///< One 64-bit word
+#define USE_TRANSPOSE_SSE2 3 ///< SSE2, x86 and x86-64 host
+#define USE_TRANSPOSE_NEON 4 ///< NEON, AArch64 host
+
+#define TRANSPOSE_MODE USE_TRANSPOSE_AUTO ///< Selected option
 /// @}
 
 #endif // hV_LIST_OPTIONS_RELEASE
@@ -224,10 +224,7 @@ void hV_Screen_Buffer::line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
         {
             swap(y1, y2);
         }
-        for (uint16_t y = y1; y <= y2; y++)
-        {
-            _setPoint(x1, y, colour);
-        }
+        _setSpanV(x1, y1, y2, colour);
     }
     else if (y1 == y2)
     {
@@ -235,10 +232,7 @@ void hV_Screen_Buffer::line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
         {
             swap(x1, x2);
         }
-        for (uint16_t x = x1; x <= x2; x++)
-        {
-            _setPoint(x, y1, colour);
-        }
+        _setSpanH(x1, x2, y1, colour);
     }
     else
     {
@@ -324,13 +318,31 @@ void hV_Screen_Buffer::rectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t
         {
             swap(y1, y2);
         }
-        for (uint16_t x = x1; x <= x2; x++)
-        {
-            for (uint16_t y = y1; y <= y2; y++)
-            {
-                _setPoint(x, y, colour);
-            }
-        }
+        _setRectangle(x1, y1, x2, y2, colour);
+    }
+}
+
+void hV_Screen_Buffer::_setSpanH(uint16_t x1, uint16_t x2, uint16_t y1, uint16_t colour)
+{
+    for (uint16_t x = x1; x <= x2; x++)
+    {
+        _setPoint(x, y1, colour);
+    }
+}
+
+void hV_Screen_Buffer::_setSpanV(uint16_t x1, uint16_t y1, uint16_t y2, uint16_t colour)
+{
+    for (uint16_t y = y1; y <= y2; y++)
+    {
+        _setPoint(x1, y, colour);
+    }
+}
+
+void hV_Screen_Buffer::_setRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour)
+{
+    for (uint16_t y = y1; y <= y2; y++)
+    {
+        _setSpanH(x1, x2, y, colour);
     }
 }
 
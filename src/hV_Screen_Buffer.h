@@ -371,6 +371,38 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     ///
     virtual void _setPoint(uint16_t x1, uint16_t y1, uint16_t colour) = 0; // compulsory
 
+    // Spans
+    ///
+    /// @brief Set horizontal span
+    /// @param x1 first x coordinate
+    /// @param x2 last x coordinate, x1 <= x2
+    /// @param y1 y coordinate
+    /// @param colour 16-bit colour
+    /// @note Default calls _setPoint() for each point, to be optimised by the screen
+    ///
+    virtual void _setSpanH(uint16_t x1, uint16_t x2, uint16_t y1, uint16_t colour);
+
+    ///
+    /// @brief Set vertical span
+    /// @param x1 x coordinate
+    /// @param y1 first y coordinate
+    /// @param y2 last y coordinate, y1 <= y2
+    /// @param colour 16-bit colour
+    /// @note Default calls _setPoint() for each point, to be optimised by the screen
+    ///
+    virtual void _setSpanV(uint16_t x1, uint16_t y1, uint16_t y2, uint16_t colour);
+
+    ///
+    /// @brief Set solid rectangle
+    /// @param x1 top left coordinate, x-axis
+    /// @param y1 top left coordinate, y-axis
+    /// @param x2 bottom right coordinate, x-axis, x1 <= x2
+    /// @param y2 bottom right coordinate, y-axis, y1 <= y2
+    /// @param colour 16-bit colour
+    /// @note Default calls _setSpanH() for each line, to be optimised by the screen
+    ///
+    virtual void _setRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour);
+
     // Write and Read
 
     // Other functions
@@ -0,0 +1,200 @@
+//
+// hV_Storage.cpp
+// Library C++ code
+// ----------------------------------
+//
+// Project Pervasive Displays Library Suite
+// Based on highView technology
+//
+// Created by Rei Vilo, 21 Jan 2024
+//
+// Copyright (c) Rei Vilo, 2010-2023
+// Licence Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+//
+// See hV_Storage.h for references
+//
+// Release 704: Added storage for internal, PSRAM and external SPI memory
+//
+
+// Library header
+#include "hV_Storage.h"
+
+// SPI memory commands, 23LC1024 and MB85RS
+#define STORAGE_COMMAND_WRITE_ENABLE 0x06
+#define STORAGE_COMMAND_WRITE 0x02
+#define STORAGE_COMMAND_READ 0x03
+
+hV_Storage::hV_Storage()
+{
+    s_type = STORAGE_NONE;
+    s_size = 0;
+    s_pinCS = NOT_CONNECTED;
+    s_addressBytes = 3;
+    s_memory = 0; // nullptr
+    resetStatistics();
+}
+
+bool hV_Storage::begin(uint8_t type, uint32_t size, uint8_t pinCS, uint8_t addressBytes)
+{
+    if ((s_type != STORAGE_NONE) or (size == 0) or (addressBytes < 2) or (addressBytes > 3))
+    {
+        return false;
+    }
+
+    switch (type)
+    {
+        case STORAGE_INTERNAL:
+        case STORAGE_HOST:
+
+            s_memory = new uint8_t[size];
+            break;
+
+        case STORAGE_PSRAM:
+
+#if defined(BOARD_HAS_PSRAM) // ESP32 PSRAM specific case
+
+            s_memory = (uint8_t *) ps_malloc(size);
+
+#else // default case
+
+            s_memory = new uint8_t[size];
+
+#endif // ESP32 BOARD_HAS_PSRAM
+            break;
+
+        case STORAGE_SPI_SRAM:
+        case STORAGE_SPI_FRAM:
+
+            if (pinCS == NOT_CONNECTED)
+            {
+                return false;
+            }
+            pinMode(pinCS, OUTPUT);
+            digitalWrite(pinCS, HIGH);
+            break;
+
+        default:
+
+            return false;
+    }
+
+    if ((type != STORAGE_SPI_SRAM) and (type != STORAGE_SPI_FRAM) and (s_memory == 0))
+    {
+        return false;
+    }
+
+    s_type = type;
+    s_size = size;
+    s_pinCS = pinCS;
+    s_addressBytes = addressBytes;
+    resetStatistics();
+    return true;
+}
+
+void hV_Storage::s_select(uint8_t command, uint32_t address)
+{
+    // FRAM, write enabled before each write
+    if ((command == STORAGE_COMMAND_WRITE) and (s_type == STORAGE_SPI_FRAM))
+    {
+        digitalWrite(s_pinCS, LOW);
+        SPI.transfer(STORAGE_COMMAND_WRITE_ENABLE);
+        digitalWrite(s_pinCS, HIGH);
+    }
+
+    // Command and address, chip selected until the end of the block
+    digitalWrite(s_pinCS, LOW);
+    SPI.transfer(command);
+    for (int8_t index = s_addressBytes - 1; index >= 0; index--)
+    {
+        SPI.transfer((address >> (index * 8)) & 0xff);
+    }
+}
+
+void hV_Storage::read(uint32_t address, uint8_t * data, uint32_t size)
+{
+    s_statistics.reads++;
+    s_statistics.readBytes += size;
+
+    switch (s_type)
+    {
+        case STORAGE_SPI_SRAM:
+        case STORAGE_SPI_FRAM:
+
+            s_select(STORAGE_COMMAND_READ, address);
+            for (uint32_t index = 0; index < size; index++)
+            {
+                data[index] = SPI.transfer(0x00);
+            }
+            digitalWrite(s_pinCS, HIGH);
+            s_statistics.busBytes += 1 + s_addressBytes + size;
+            break;
+
+        case STORAGE_HOST:
+
+            s_statistics.busBytes += 1 + s_addressBytes + size;
+            memcpy(data, s_memory + address, size);
+            break;
+
+        default:
+
+            memcpy(data, s_memory + address, size);
+            break;
+    }
+}
+
+void hV_Storage::write(uint32_t address, const uint8_t * data, uint32_t size)
+{
+    s_statistics.writes++;
+    s_statistics.writtenBytes += size;
+
+    switch (s_type)
+    {
+        case STORAGE_SPI_SRAM:
+        case STORAGE_SPI_FRAM:
+
+            s_select(STORAGE_COMMAND_WRITE, address);
+            for (uint32_t index = 0; index < size; index++)
+            {
+                SPI.transfer(data[index]);
+            }
+            digitalWrite(s_pinCS, HIGH);
+            s_statistics.busBytes += 1 + s_addressBytes + size + ((s_type == STORAGE_SPI_FRAM) ? 1 : 0);
+            break;
+
+        case STORAGE_HOST:
+
+            s_statistics.busBytes += 1 + s_addressBytes + size;
+            memcpy(s_memory + address, data, size);
+            break;
+
+        default:
+
+            memcpy(s_memory + address, data, size);
+            break;
+    }
+}
+
+uint8_t hV_Storage::getType()
+{
+    return s_type;
+}
+
+uint32_t hV_Storage::getSize()
+{
+    return s_size;
+}
+
+bool hV_Storage::isExternal()
+{
+    return (s_type == STORAGE_SPI_SRAM) or (s_type == STORAGE_SPI_FRAM);
+}
+
+storageStatistics_s hV_Storage::getStatistics()
+{
+    return s_statistics;
+}
+
+void hV_Storage::resetStatistics()
+{
+    memset(&s_statistics, 0x00, sizeof(s_statistics));
+}
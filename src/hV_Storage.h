@@ -0,0 +1,144 @@
+///
+/// @file hV_Storage.h
+/// @brief Storage for the frame-buffer, internal, PSRAM or external SPI memory
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// * Edition: Basic
+///
+/// @author Rei Vilo
+/// @date 21 Jan 2024
+/// @version 704
+///
+/// @copyright (c) Rei Vilo, 2010-2023
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+///
+/// @see Screen_EPD_EXT3_Fast::beginStorage()
+///
+
+// SDK
+#include "hV_HAL_Peripherals.h"
+
+// Configuration
+#include "hV_Configuration.h"
+
+#ifndef hV_STORAGE_RELEASE
+///
+/// @brief Library release number
+///
+#define hV_STORAGE_RELEASE 704
+
+///
+/// @brief Storage types
+/// @note Numbers are sequential and exclusive
+///
+/// @{
+#define STORAGE_NONE 0x00 ///< Not initialised
+#define STORAGE_INTERNAL 0x01 ///< MCU internal SRAM
+#define STORAGE_PSRAM 0x02 ///< ESP32 PSRAM, MCU internal SRAM otherwise
+#define STORAGE_SPI_SRAM 0x03 ///< External SPI SRAM, eg. 23LC1024
+#define STORAGE_SPI_FRAM 0x04 ///< External SPI FRAM, eg. MB85RS
+#define STORAGE_HOST 0x05 ///< MCU internal SRAM standing in for external SPI memory, bus bytes counted
+/// @}
+
+///
+/// @brief Accesses to the storage
+/// @note Counted for all types
+///
+struct storageStatistics_s
+{
+    uint32_t reads; ///< Block reads
+    uint32_t writes; ///< Block writes
+    uint32_t readBytes; ///< Bytes read
+    uint32_t writtenBytes; ///< Bytes written
+    uint32_t busBytes; ///< Bytes on the SPI bus with command and address, external SPI and host only
+};
+
+///
+/// @brief Class for the storage of the frame-buffer
+/// @details Block reads and writes only, with one command and address per block for external SPI memory
+/// @note External SPI memory shares the SPI bus and the settings of the screen, with its own chip select
+///
+class hV_Storage
+{
+  public:
+    ///
+    /// @brief Constructor
+    ///
+    hV_Storage();
+
+    ///
+    /// @brief Initialisation
+    /// @param type STORAGE_INTERNAL, STORAGE_PSRAM, STORAGE_SPI_SRAM, STORAGE_SPI_FRAM or STORAGE_HOST
+    /// @param size bytes, see Screen_EPD_EXT3_Fast::frameBufferSize()
+    /// @param pinCS chip select of external SPI memory, default = NOT_CONNECTED
+    /// @param addressBytes address of external SPI memory, default = 3, eg. 23LC1024, MB85RS1MT,
+    /// 2 for memories up to 64 kB, eg. 23K256, MB85RS256
+    /// @return true if success, false if memory not allocated or chip select missing
+    /// @note Internal, PSRAM and host storage allocated on the heap
+    /// @note SPI initialised by the screen, call before Screen_EPD_EXT3_Fast::beginStorage()
+    ///
+    bool begin(uint8_t type, uint32_t size, uint8_t pinCS = NOT_CONNECTED, uint8_t addressBytes = 3);
+
+    ///
+    /// @brief Read a block
+    /// @param address first byte
+    /// @param data buffer in MCU internal SRAM
+    /// @param size bytes
+    ///
+    void read(uint32_t address, uint8_t * data, uint32_t size);
+
+    ///
+    /// @brief Write a block
+    /// @param address first byte
+    /// @param data buffer in MCU internal SRAM
+    /// @param size bytes
+    ///
+    void write(uint32_t address, const uint8_t * data, uint32_t size);
+
+    ///
+    /// @brief Get the type
+    /// @return STORAGE_* type
+    ///
+    uint8_t getType();
+
+    ///
+    /// @brief Get the size
+    /// @return bytes
+    ///
+    uint32_t getSize();
+
+    ///
+    /// @brief Check whether the storage shares the SPI bus of the screen
+    /// @return true for external SPI memory
+    ///
+    bool isExternal();
+
+    ///
+    /// @brief Get the accesses since begin or reset
+    /// @return statistics, see storageStatistics_s
+    ///
+    storageStatistics_s getStatistics();
+
+    ///
+    /// @brief Reset the accesses
+    ///
+    void resetStatistics();
+
+    /// @cond
+  protected:
+
+    void s_select(uint8_t command, uint32_t address);
+
+    uint8_t s_type;
+    uint32_t s_size;
+    uint8_t s_pinCS;
+    uint8_t s_addressBytes; // external SPI memory
+    uint8_t * s_memory; // internal, PSRAM and host
+    storageStatistics_s s_statistics;
+    /// @endcond
+};
+
+#endif // hV_STORAGE_RELEASE
+
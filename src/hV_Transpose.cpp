@@ -0,0 +1,147 @@
+//
+// hV_Transpose.cpp
+// Library C++ code
+// ----------------------------------
+//
+// Project Pervasive Displays Library Suite
+// Based on highView technology
+//
+// Created by Rei Vilo, 21 Jan 2024
+//
+// Copyright (c) Rei Vilo, 2010-2023
+// Licence Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+//
+// See hV_Transpose.h for references
+//
+// Release 704: Added 8x8 bit-matrix transpose kernels
+//
+
+// Library header
+#include "hV_Transpose.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif // __SSE2__
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif // __aarch64__
+
+void transpose8x8Word32(const uint8_t * source, uint16_t stride, uint8_t * target)
+{
+    // Rows 0-3 and 4-7, first row in the most significant byte
+    uint32_t upper = ((uint32_t)source[0] << 24) | ((uint32_t)source[stride] << 16) |
+                     ((uint32_t)source[2 * stride] << 8) | source[3 * stride];
+    uint32_t lower = ((uint32_t)source[4 * stride] << 24) | ((uint32_t)source[5 * stride] << 16) |
+                     ((uint32_t)source[6 * stride] << 8) | source[7 * stride];
+    uint32_t swapped;
+
+    // 2x2 blocks, then 4x4 blocks within each word
+    swapped = (upper ^ (upper >> 7)) & 0x00aa00aa;
+    upper = upper ^ swapped ^ (swapped << 7);
+    swapped = (lower ^ (lower >> 7)) & 0x00aa00aa;
+    lower = lower ^ swapped ^ (swapped << 7);
+
+    swapped = (upper ^ (upper >> 14)) & 0x0000cccc;
+    upper = upper ^ swapped ^ (swapped << 14);
+    swapped = (lower ^ (lower >> 14)) & 0x0000cccc;
+    lower = lower ^ swapped ^ (swapped << 14);
+
+    // 4x4 blocks between the words
+    swapped = (upper & 0xf0f0f0f0) | ((lower >> 4) & 0x0f0f0f0f);
+    lower = ((upper << 4) & 0xf0f0f0f0) | (lower & 0x0f0f0f0f);
+    upper = swapped;
+
+    target[0] = upper >> 24;
+    target[1] = upper >> 16;
+    target[2] = upper >> 8;
+    target[3] = upper;
+    target[4] = lower >> 24;
+    target[5] = lower >> 16;
+    target[6] = lower >> 8;
+    target[7] = lower;
+}
+
+void transpose8x8Word64(const uint8_t * source, uint16_t stride, uint8_t * target)
+{
+    // Rows 0-7, first row in the most significant byte
+    uint64_t value = ((uint64_t)source[0] << 56) | ((uint64_t)source[stride] << 48) |
+                     ((uint64_t)source[2 * stride] << 40) | ((uint64_t)source[3 * stride] << 32) |
+                     ((uint64_t)source[4 * stride] << 24) | ((uint64_t)source[5 * stride] << 16) |
+                     ((uint64_t)source[6 * stride] << 8) | source[7 * stride];
+
+    // 2x2, 4x4 then 8x8 blocks
+    uint64_t swapped;
+    swapped = (value ^ (value >> 7)) & 0x00aa00aa00aa00aaULL;
+    value = value ^ swapped ^ (swapped << 7);
+    swapped = (value ^ (value >> 14)) & 0x0000cccc0000ccccULL;
+    value = value ^ swapped ^ (swapped << 14);
+    swapped = (value ^ (value >> 28)) & 0x00000000f0f0f0f0ULL;
+    value = value ^ swapped ^ (swapped << 28);
+
+    target[0] = value >> 56;
+    target[1] = value >> 48;
+    target[2] = value >> 40;
+    target[3] = value >> 32;
+    target[4] = value >> 24;
+    target[5] = value >> 16;
+    target[6] = value >> 8;
+    target[7] = value;
+}
+
+#if defined(__SSE2__)
+void transpose8x8SSE2(const uint8_t * source, uint16_t stride, uint8_t * target)
+{
+    // First row in lane 7, so its bit lands on bit 7 of the movemask
+    uint64_t rows = ((uint64_t)source[0] << 56) | ((uint64_t)source[stride] << 48) |
+                    ((uint64_t)source[2 * stride] << 40) | ((uint64_t)source[3 * stride] << 32) |
+                    ((uint64_t)source[4 * stride] << 24) | ((uint64_t)source[5 * stride] << 16) |
+                    ((uint64_t)source[6 * stride] << 8) | source[7 * stride];
+    __m128i value = _mm_loadl_epi64((const __m128i *)&rows);
+
+    // One column per movemask, next bit moved to the top of each lane
+    for (uint8_t index = 0; index < 8; index++)
+    {
+        target[index] = _mm_movemask_epi8(value);
+        value = _mm_add_epi8(value, value);
+    }
+}
+#endif // __SSE2__
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+void transpose8x8NEON(const uint8_t * source, uint16_t stride, uint8_t * target)
+{
+    uint8_t rows[8];
+    for (uint8_t index = 0; index < 8; index++)
+    {
+        rows[index] = source[index * stride];
+    }
+
+    // Bit 7 - column of row i moved to bit 7 - i, then the 8 lanes added
+    static const int8_t shifts[8] = {0, -1, -2, -3, -4, -5, -6, -7};
+    static const uint8_t bits[8] = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+    uint8x8_t value = vld1_u8(rows);
+    int8x8_t shift = vld1_s8(shifts);
+    uint8x8_t select = vld1_u8(bits);
+
+    for (uint8_t index = 0; index < 8; index++)
+    {
+        target[index] = vaddv_u8(vand_u8(vshl_u8(value, shift), select));
+        shift = vadd_s8(shift, vdup_n_s8(1));
+    }
+}
+#endif // __aarch64__
+
+void transpose8x8(const uint8_t * source, uint16_t stride, uint8_t * target)
+{
+#if (TRANSPOSE_KERNEL == USE_TRANSPOSE_SSE2)
+    transpose8x8SSE2(source, stride, target);
+#elif (TRANSPOSE_KERNEL == USE_TRANSPOSE_NEON)
+    transpose8x8NEON(source, stride, target);
+#elif (TRANSPOSE_KERNEL == USE_TRANSPOSE_64)
+    transpose8x8Word64(source, stride, target);
+#else
+    transpose8x8Word32(source, stride, target);
+#endif // TRANSPOSE_KERNEL
+}
+
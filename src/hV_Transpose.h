@@ -0,0 +1,85 @@
+///
+/// @file hV_Transpose.h
+/// @brief 8x8 bit-matrix transpose kernels
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// * Edition: Basic
+///
+/// @author Rei Vilo
+/// @date 21 Jan 2024
+/// @version 704
+///
+/// @copyright (c) Rei Vilo, 2010-2023
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+///
+/// @see Screen_EPD_EXT3_Fast::setLayer()
+///
+
+// SDK
+#include "hV_HAL_Peripherals.h"
+
+// Configuration
+#include "hV_Configuration.h"
+
+#ifndef hV_TRANSPOSE_RELEASE
+///
+/// @brief Library release number
+///
+#define hV_TRANSPOSE_RELEASE 704
+
+///
+/// @brief Kernel used by transpose8x8()
+/// @note TRANSPOSE_MODE resolved for the target, see hV_List_Options.h
+///
+#if (TRANSPOSE_MODE == USE_TRANSPOSE_AUTO)
+#if (UINTPTR_MAX > 0xffffffff)
+#define TRANSPOSE_KERNEL USE_TRANSPOSE_64
+#else
+#define TRANSPOSE_KERNEL USE_TRANSPOSE_32
+#endif // UINTPTR_MAX
+#else
+#define TRANSPOSE_KERNEL TRANSPOSE_MODE
+#endif // TRANSPOSE_MODE
+
+///
+/// @brief Transpose an 8x8 bit-matrix, selected kernel
+/// @param source 8 rows of 8 bits, one byte per row, stride bytes apart
+/// @param stride bytes between two rows of the source
+/// @param target 8 columns of 8 bits, one byte per column, contiguous
+/// @note Bit 7 - i of target[j] = bit 7 - j of source[i * stride], 0x80 for the first row and column
+///
+void transpose8x8(const uint8_t * source, uint16_t stride, uint8_t * target);
+
+///
+/// @brief Transpose an 8x8 bit-matrix, two 32-bit words
+/// @note Same parameters as transpose8x8(), for all targets
+///
+void transpose8x8Word32(const uint8_t * source, uint16_t stride, uint8_t * target);
+
+///
+/// @brief Transpose an 8x8 bit-matrix, one 64-bit word
+/// @note Same parameters as transpose8x8(), for all targets, slower on 32-bit MCU
+///
+void transpose8x8Word64(const uint8_t * source, uint16_t stride, uint8_t * target);
+
+#if defined(__SSE2__)
+///
+/// @brief Transpose an 8x8 bit-matrix, SSE2
+/// @note Same parameters as transpose8x8(), x86 and x86-64 host only
+/// @note Limited by the 8 loads of the rows, on par with transpose8x8Word64()
+///
+void transpose8x8SSE2(const uint8_t * source, uint16_t stride, uint8_t * target);
+#endif // __SSE2__
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+///
+/// @brief Transpose an 8x8 bit-matrix, NEON
+/// @note Same parameters as transpose8x8(), AArch64 host only
+///
+void transpose8x8NEON(const uint8_t * source, uint16_t stride, uint8_t * target);
+#endif // __aarch64__
+
+#endif // hV_TRANSPOSE_RELEASE
+
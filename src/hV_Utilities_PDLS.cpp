@@ -90,7 +90,18 @@ void hV_Utilities_PDLS::invert(bool flag)
 //
 void hV_Utilities_PDLS::setTemperatureC(int8_t temperatureC)
 {
-    u_temperature = temperatureC;
+    // Exponential moving average, 1/16 °C
+    int16_t temperature16 = temperatureC * 16;
+    if ((u_temperatureSeeded == false) or (u_temperatureSmoothing <= 1))
+    {
+        u_temperatureSmoothed = temperature16;
+        u_temperatureSeeded = true;
+    }
+    else
+    {
+        u_temperatureSmoothed += (temperature16 - u_temperatureSmoothed) / u_temperatureSmoothing;
+    }
+    u_temperature = (u_temperatureSmoothed >= 0) ? (u_temperatureSmoothed + 8) / 16 : (u_temperatureSmoothed - 8) / 16;
 
     // uint8_t u_temperature2;
     // if (u_temperature < 0)
@@ -111,6 +122,33 @@ void hV_Utilities_PDLS::setTemperatureF(int16_t temperatureF)
     setTemperatureC(temperatureC);
 }
 
+void hV_Utilities_PDLS::setTemperatureGovernor(uint8_t hysteresis, uint8_t smoothing)
+{
+    u_temperatureHysteresis = hysteresis;
+    u_temperatureSmoothing = (smoothing > 0) ? smoothing : 1;
+}
+
+bool hV_Utilities_PDLS::u_checkTemperatureFast(int8_t minimum, int8_t maximum)
+{
+    // Leave at the limits, resume hysteresis inside the limits
+    if (u_temperatureFast)
+    {
+        if ((u_temperature < minimum) or (u_temperature > maximum))
+        {
+            u_temperatureFast = false;
+        }
+    }
+    else
+    {
+        if ((u_temperature >= minimum + u_temperatureHysteresis) and (u_temperature <= maximum - u_temperatureHysteresis))
+        {
+            u_temperatureFast = true;
+        }
+    }
+
+    return u_temperatureFast;
+}
+
 uint8_t hV_Utilities_PDLS::checkTemperatureMode(uint8_t updateMode)
 {
     // #define FEATURE_FAST 0x01 ///< With embedded fast update
@@ -131,7 +169,7 @@ uint8_t hV_Utilities_PDLS::checkTemperatureMode(uint8_t updateMode)
             // Fast 	PS 	Embedded fast update 	FU: +15 to +30 °C 	GU: 0 to +50 °C
             if (updateMode == UPDATE_FAST) // Fast update
             {
-                if ((u_temperature < 15) or (u_temperature > 30))
+                if (u_checkTemperatureFast(15, 30) == false)
                 {
                     updateMode = UPDATE_GLOBAL;
                 }
@@ -150,7 +188,7 @@ uint8_t hV_Utilities_PDLS::checkTemperatureMode(uint8_t updateMode)
             // Wide 	KS 	Wide temperature and embedded fast update 	FU: 0 to +50 °C 	GU: -15 to +60 °C
             if (updateMode == UPDATE_FAST) // Fast update
             {
-                if ((u_temperature < 0) or (u_temperature > 50))
+                if (u_checkTemperatureFast(0, 50) == false)
                 {
                     updateMode = UPDATE_GLOBAL;
                 }
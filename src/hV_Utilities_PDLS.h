@@ -76,20 +76,33 @@ class hV_Utilities_PDLS : public hV_Board
     ///
     void setTemperatureF(int16_t temperatureF = 77);
 
+    ///
+    /// @brief Set the temperature governor
+    /// @details Smoothing and hysteresis on the temperature, to avoid alternate fast and global updates
+    /// when the temperature is close to the limit for fast update
+    /// @param hysteresis in °C, fast update leaves at the limits and resumes hysteresis inside the limits, default = 2
+    /// @param smoothing number of readings averaged by exponential moving average, 1 = none, default = 1
+    /// @note Fast update is only used within the limits of the data-sheet
+    /// @note With hysteresis = 0 and smoothing = 1, the mode follows the temperature immediately
+    ///
+    void setTemperatureGovernor(uint8_t hysteresis = 2, uint8_t smoothing = 1);
+
     ///
     /// @brief Check the mode against the temperature
     ///
     /// @param updateMode expected update mode
     /// @return uint8_t recommended mode
     /// @note If required, defaulting to UPDATE_GLOBAL or UPDATE_NONE
+    /// @note Fast update is governed by the hysteresis set by setTemperatureGovernor()
     /// @warning Default temperature is 25 °C, otherwise set by setTemperatureC() or setTemperatureF()
     ///
     uint8_t checkTemperatureMode(uint8_t updateMode);
 
     ///
     /// @brief Invert screen
-    /// @details Invert black and white colours
+    /// @details Invert black and white colours of the whole screen, including what is already drawn
     /// @param flag true to invert, false for normal screen
+    /// @note Applied to the frame-buffer when sent to the screen, at the next update
     ///
     void invert(bool flag);
 
@@ -107,6 +120,14 @@ class hV_Utilities_PDLS : public hV_Board
     ///
     void u_WhoAmI(char * answer);
 
+    ///
+    /// @brief Governed fast update
+    /// @param minimum lowest temperature for fast update, °C
+    /// @param maximum highest temperature for fast update, °C
+    /// @return true if fast update allowed
+    ///
+    bool u_checkTemperatureFast(int8_t minimum, int8_t maximum);
+
     // Screen dependent variables
 #if (SRAM_MODE == USE_INTERNAL_MCU)
 
@@ -120,6 +141,11 @@ class hV_Utilities_PDLS : public hV_Board
 
     eScreen_EPD_EXT3_t u_eScreen_EPD_EXT3;
     int8_t u_temperature = 25;
+    int16_t u_temperatureSmoothed = 25 * 16; // 1/16 °C
+    bool u_temperatureSeeded = false; // first reading not averaged
+    uint8_t u_temperatureHysteresis = 2; // °C
+    uint8_t u_temperatureSmoothing = 1; // readings
+    bool u_temperatureFast = true; // governed state
     uint8_t u_codeExtra;
     uint8_t u_codeSize;
     uint8_t u_codeType;